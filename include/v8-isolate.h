@@ -1362,6 +1362,15 @@ class V8_EXPORT Isolate {
    */
   void SetRAILMode(RAILMode rail_mode);
 
+  /**
+   * Optional target for the maximum duration of individual garbage collection
+   * pauses, in milliseconds. V8 uses the pause times it observes to size
+   * incremental marking steps, the young generation and the amount of
+   * compaction so that pauses stay below the target where possible. Passing
+   * 0 restores the default heuristics.
+   */
+  void SetGarbageCollectionPauseTarget(double max_pause_ms);
+
   /**
    * Update load start time of the RAIL mode
    */
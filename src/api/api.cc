@@ -65,6 +65,7 @@
 #include "src/handles/shared-object-conveyor-handles.h"
 #include "src/handles/traced-handles.h"
 #include "src/heap/embedder-tracing.h"
+#include "src/heap/gc-pause-controller.h"
 #include "src/heap/heap-inl.h"
 #include "src/heap/heap-write-barrier.h"
 #include "src/heap/safepoint.h"
@@ -9633,6 +9634,11 @@ void Isolate::SetRAILMode(RAILMode rail_mode) {
   return i_isolate->SetRAILMode(rail_mode);
 }
 
+void Isolate::SetGarbageCollectionPauseTarget(double max_pause_ms) {
+  i::Isolate* i_isolate = reinterpret_cast<i::Isolate*>(this);
+  i_isolate->heap()->pause_controller()->SetMaxPause(max_pause_ms);
+}
+
 void Isolate::UpdateLoadStartTime() {
   i::Isolate* i_isolate = reinterpret_cast<i::Isolate*>(this);
   i_isolate->UpdateLoadStartTime();
@@ -47,6 +47,7 @@ class V8_BASE_EXPORT CPU final {
   static const int kArm = 0x41;
   static const int kNvidia = 0x4e;
   static const int kQualcomm = 0x51;
+  static const int kApple = 0x61;
   int architecture() const { return architecture_; }
   int variant() const { return variant_; }
   static const int kNvidiaDenver = 0x0;
@@ -60,6 +61,17 @@ class V8_BASE_EXPORT CPU final {
   static const int kArmCortexA12 = 0xc0c;
   static const int kArmCortexA15 = 0xc0f;
 
+  // ARM64-specific part codes
+  static const int kArmCortexA53 = 0xd03;
+  static const int kArmCortexA55 = 0xd05;
+  static const int kArmCortexA76 = 0xd0b;
+  static const int kArmNeoverseN1 = 0xd0c;
+  static const int kArmCortexA77 = 0xd0d;
+  static const int kArmNeoverseV1 = 0xd40;
+  static const int kArmCortexA78 = 0xd41;
+  static const int kArmCortexX1 = 0xd44;
+  static const int kArmNeoverseN2 = 0xd49;
+
   // Denver-specific part code
   static const int kNvidiaDenverV10 = 0x002;
 
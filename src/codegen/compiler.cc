@@ -1045,6 +1045,9 @@ bool CompileTurbofan_NotConcurrent(Isolate* isolate,
                              compilation_info->osr_offset(),
                              ToCodeT(*compilation_info->code()),
                              compilation_info->function_context_specializing());
+  if (V8_UNLIKELY(v8_flags.code_cache_tiering_hints)) {
+    compilation_info->shared_info()->set_turbofan_tier_up_hint(true);
+  }
   job->RecordFunctionCompilation(LogEventListener::CodeTag::kFunction, isolate);
   return true;
 }
@@ -3939,6 +3942,9 @@ void Compiler::FinalizeTurbofanCompilationJob(TurbofanCompilationJob* job,
             isolate, *compilation_info->closure(),
             compilation_info->osr_offset(), ToCodeT(*compilation_info->code()),
             compilation_info->function_context_specializing());
+        if (V8_UNLIKELY(v8_flags.code_cache_tiering_hints)) {
+          shared->set_turbofan_tier_up_hint(true);
+        }
         CompilerTracer::TraceCompletedJob(isolate, compilation_info);
         if (IsOSR(osr_offset)) {
           CompilerTracer::TraceOptimizeOSRFinished(isolate, function,
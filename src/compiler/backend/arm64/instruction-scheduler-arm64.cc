@@ -2,7 +2,9 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include "src/base/cpu.h"
 #include "src/compiler/backend/instruction-scheduler.h"
+#include "src/flags/flags.h"
 
 namespace v8 {
 namespace internal {
@@ -373,9 +375,144 @@ int InstructionScheduler::GetTargetInstructionFlags(
   UNREACHABLE();
 }
 
+namespace {
+
+// Latencies, in cycles, of the main classes of instructions on a family of
+// microarchitectures. The scheduler issues at most one instruction per cycle,
+// so the throughput of the execution pipelines is not modeled.
+struct LatencyModel {
+  // Data processing instructions with a shifted or extended operand.
+  int shifted_operand;
+  int load;
+  int mul32;
+  int mul64;
+  int div32;
+  int div64;
+  // Add, sub, min and max, scalar or vector.
+  int fp_add;
+  // Abs, neg and comparisons.
+  int fp_misc;
+  int fp_mul;
+  int float32_div;
+  int float64_div;
+  int float32_sqrt;
+  int float64_sqrt;
+  // Conversions and rounding.
+  int fp_convert;
+  int simd_int_mul;
+};
+
+// Latencies for CPUs without a specific model, which have been determined in
+// an empirical way.
+constexpr LatencyModel kGenericModel = {
+    /* shifted_operand */ 3,
+    /* load */ 11,
+    /* mul32 */ 3,
+    /* mul64 */ 5,
+    /* div32 */ 12,
+    /* div64 */ 20,
+    /* fp_add */ 5,
+    /* fp_misc */ 3,
+    /* fp_mul */ 5,
+    /* float32_div */ 12,
+    /* float64_div */ 19,
+    /* float32_sqrt */ 12,
+    /* float64_sqrt */ 19,
+    /* fp_convert */ 5,
+    /* simd_int_mul */ 4,
+};
+
+// In-order little cores: Cortex-A53 and Cortex-A55.
+constexpr LatencyModel kCortexA55Model = {
+    /* shifted_operand */ 2,
+    /* load */ 3,
+    /* mul32 */ 3,
+    /* mul64 */ 4,
+    /* div32 */ 12,
+    /* div64 */ 20,
+    /* fp_add */ 4,
+    /* fp_misc */ 3,
+    /* fp_mul */ 4,
+    /* float32_div */ 13,
+    /* float64_div */ 22,
+    /* float32_sqrt */ 12,
+    /* float64_sqrt */ 22,
+    /* fp_convert */ 4,
+    /* simd_int_mul */ 4,
+};
+
+// Out-of-order big cores derived from the Cortex-A76: Cortex-A76, A77, A78,
+// X1 and Neoverse N1, N2 and V1.
+constexpr LatencyModel kCortexA76Model = {
+    /* shifted_operand */ 2,
+    /* load */ 4,
+    /* mul32 */ 2,
+    /* mul64 */ 2,
+    /* div32 */ 12,
+    /* div64 */ 20,
+    /* fp_add */ 2,
+    /* fp_misc */ 2,
+    /* fp_mul */ 3,
+    /* float32_div */ 10,
+    /* float64_div */ 15,
+    /* float32_sqrt */ 11,
+    /* float64_sqrt */ 17,
+    /* fp_convert */ 3,
+    /* simd_int_mul */ 4,
+};
+
+// Apple cores, since the M1.
+constexpr LatencyModel kAppleModel = {
+    /* shifted_operand */ 2,
+    /* load */ 4,
+    /* mul32 */ 3,
+    /* mul64 */ 3,
+    /* div32 */ 7,
+    /* div64 */ 7,
+    /* fp_add */ 3,
+    /* fp_misc */ 2,
+    /* fp_mul */ 4,
+    /* float32_div */ 10,
+    /* float64_div */ 10,
+    /* float32_sqrt */ 13,
+    /* float64_sqrt */ 13,
+    /* fp_convert */ 3,
+    /* simd_int_mul */ 3,
+};
+
+const LatencyModel& GetLatencyModel() {
+  static const LatencyModel& model = []() -> const LatencyModel& {
+    // Builtins are scheduled when creating the snapshot, which should not
+    // depend on the host.
+    if (v8_flags.predictable) return kGenericModel;
+    base::CPU cpu;
+    if (cpu.implementer() == base::CPU::kApple) return kAppleModel;
+    if (cpu.implementer() != base::CPU::kArm) return kGenericModel;
+    switch (cpu.part()) {
+      case base::CPU::kArmCortexA53:
+      case base::CPU::kArmCortexA55:
+        return kCortexA55Model;
+      case base::CPU::kArmCortexA76:
+      case base::CPU::kArmCortexA77:
+      case base::CPU::kArmCortexA78:
+      case base::CPU::kArmCortexX1:
+      case base::CPU::kArmNeoverseN1:
+      case base::CPU::kArmNeoverseN2:
+      case base::CPU::kArmNeoverseV1:
+        return kCortexA76Model;
+      default:
+        return kGenericModel;
+    }
+  }();
+  return model;
+}
+
+}  // namespace
+
 int InstructionScheduler::GetInstructionLatency(const Instruction* instr) {
-  // Basic latency modeling for arm64 instructions. They have been determined
-  // in an empirical way.
+  // The latencies of arm64 instructions depend on the microarchitecture of
+  // the host, which is detected on first use.
+  const LatencyModel& model = GetLatencyModel();
   switch (instr->arch_opcode()) {
     case kArm64Add:
     case kArm64Add32:
@@ -402,7 +539,7 @@ int InstructionScheduler::GetInstructionLatency(const Instruction* instr) {
     case kArm64Tst:
     case kArm64Tst32:
       if (instr->addressing_mode() != kMode_None) {
-        return 3;
+        return model.shifted_operand;
       } else {
         return 1;
       }
@@ -442,7 +579,8 @@ int InstructionScheduler::GetInstructionLatency(const Instruction* instr) {
     case kArm64Ldrsb:
     case kArm64Ldrsh:
     case kArm64Ldrsw:
-      return 11;
+    case kArm64LdrQ:
+      return model.load;
 
     case kArm64Str:
     case kArm64StrD:
@@ -456,27 +594,35 @@ int InstructionScheduler::GetInstructionLatency(const Instruction* instr) {
     case kArm64Mneg32:
     case kArm64Msub32:
     case kArm64Mul32:
-      return 3;
+      return model.mul32;
 
     case kArm64Madd:
     case kArm64Mneg:
     case kArm64Msub:
     case kArm64Mul:
-      return 5;
+      return model.mul64;
 
     case kArm64Idiv32:
     case kArm64Udiv32:
-      return 12;
+      return model.div32;
 
     case kArm64Idiv:
     case kArm64Udiv:
-      return 20;
+      return model.div64;
 
     case kArm64Float32Add:
     case kArm64Float32Sub:
     case kArm64Float64Add:
     case kArm64Float64Sub:
-      return 5;
+    case kArm64Float32Max:
+    case kArm64Float32Min:
+    case kArm64Float64Max:
+    case kArm64Float64Min:
+    case kArm64FAdd:
+    case kArm64FSub:
+    case kArm64FMin:
+    case kArm64FMax:
+      return model.fp_add;
 
     case kArm64Float32Abs:
     case kArm64Float32Cmp:
@@ -484,15 +630,36 @@ int InstructionScheduler::GetInstructionLatency(const Instruction* instr) {
     case kArm64Float64Abs:
     case kArm64Float64Cmp:
     case kArm64Float64Neg:
-      return 3;
+    case kArm64FAbs:
+    case kArm64FNeg:
+      return model.fp_misc;
+
+    case kArm64Float32Mul:
+    case kArm64Float32Fnmul:
+    case kArm64Float64Mul:
+    case kArm64Float64Fnmul:
+    case kArm64FMul:
+      return model.fp_mul;
 
     case kArm64Float32Div:
-    case kArm64Float32Sqrt:
-      return 12;
+      return model.float32_div;
 
     case kArm64Float64Div:
+      return model.float64_div;
+
+    case kArm64FDiv:
+      return LaneSizeField::decode(instr->opcode()) == 64 ? model.float64_div
+                                                          : model.float32_div;
+
+    case kArm64Float32Sqrt:
+      return model.float32_sqrt;
+
     case kArm64Float64Sqrt:
-      return 19;
+      return model.float64_sqrt;
+
+    case kArm64FSqrt:
+      return LaneSizeField::decode(instr->opcode()) == 64 ? model.float64_sqrt
+                                                          : model.float32_sqrt;
 
     case kArm64Float32RoundDown:
     case kArm64Float32RoundTiesEven:
@@ -503,7 +670,7 @@ int InstructionScheduler::GetInstructionLatency(const Instruction* instr) {
     case kArm64Float64RoundTiesEven:
     case kArm64Float64RoundTruncate:
     case kArm64Float64RoundUp:
-      return 5;
+      return model.fp_convert;
 
     case kArm64Float32ToFloat64:
     case kArm64Float64ToFloat32:
@@ -519,7 +686,11 @@ int InstructionScheduler::GetInstructionLatency(const Instruction* instr) {
     case kArm64Uint32ToFloat64:
     case kArm64Uint64ToFloat32:
     case kArm64Uint64ToFloat64:
-      return 5;
+      return model.fp_convert;
+
+    case kArm64I16x8Mul:
+    case kArm64I32x4Mul:
+      return model.simd_int_mul;
 
     default:
       return 2;
@@ -7,6 +7,7 @@
 #include "src/base/iterator.h"
 #include "src/base/optional.h"
 #include "src/base/utils/random-number-generator.h"
+#include "src/codegen/register-configuration.h"
 
 namespace v8 {
 namespace internal {
@@ -28,11 +29,30 @@ InstructionScheduler::ScheduleGraphNode*
 InstructionScheduler::CriticalPathFirstQueue::PopBestCandidate(int cycle) {
   DCHECK(!IsEmpty());
   auto candidate = nodes_.end();
-  for (auto iterator = nodes_.begin(); iterator != nodes_.end(); ++iterator) {
-    // We only consider instructions that have all their operands ready.
-    if (cycle >= (*iterator)->start_cycle()) {
-      candidate = iterator;
-      break;
+  if (scheduler_->IsRegisterPressureHigh()) {
+    // Pick the instruction which frees the most registers, even if its
+    // operands are not ready yet: a stall is cheaper than a spill. Ties are
+    // broken in favor of the critical path, since the list is sorted by total
+    // latency.
+    int best_delta = 0;
+    for (auto iterator = nodes_.begin(); iterator != nodes_.end();
+         ++iterator) {
+      int delta = scheduler_->HighRegisterPressureDelta(*iterator);
+      if (delta < best_delta) {
+        best_delta = delta;
+        candidate = iterator;
+      }
+    }
+  }
+
+  if (candidate == nodes_.end()) {
+    for (auto iterator = nodes_.begin(); iterator != nodes_.end();
+         ++iterator) {
+      // We only consider instructions that have all their operands ready.
+      if (cycle >= (*iterator)->start_cycle()) {
+        candidate = iterator;
+        break;
+      }
     }
   }
 
@@ -61,7 +81,10 @@ InstructionScheduler::ScheduleGraphNode::ScheduleGraphNode(Zone* zone,
                                                            Instruction* instr)
     : instr_(instr),
       successors_(zone),
+      value_inputs_(zone),
       unscheduled_predecessors_count_(0),
+      defined_values_count_{0, 0},
+      unscheduled_uses_count_(0),
       latency_(GetInstructionLatency(instr)),
       total_latency_(-1),
       start_cycle_(-1) {}
@@ -81,7 +104,12 @@ InstructionScheduler::InstructionScheduler(Zone* zone,
       pending_loads_(zone),
       last_live_in_reg_marker_(nullptr),
       last_deopt_or_trap_(nullptr),
-      operands_map_(zone) {
+      operands_map_(zone),
+      live_values_count_{0, 0},
+      register_pressure_limit_{
+          RegisterConfiguration::Default()->num_allocatable_general_registers(),
+          RegisterConfiguration::Default()
+              ->num_allocatable_double_registers()} {
   if (v8_flags.turbo_stress_instruction_scheduling) {
     random_number_generator_ =
         base::Optional<base::RandomNumberGenerator>(v8_flags.random_seed);
@@ -188,6 +216,7 @@ void InstructionScheduler::AddInstruction(Instruction* instr) {
         auto it = operands_map_.find(vreg);
         if (it != operands_map_.end()) {
           it->second->AddSuccessor(new_node);
+          new_node->AddValueInput(it->second);
         }
       }
     }
@@ -196,8 +225,9 @@ void InstructionScheduler::AddInstruction(Instruction* instr) {
     for (size_t i = 0; i < instr->OutputCount(); ++i) {
       const InstructionOperand* output = instr->OutputAt(i);
       if (output->IsUnallocated()) {
-        operands_map_[UnallocatedOperand::cast(output)->virtual_register()] =
-            new_node;
+        int32_t vreg = UnallocatedOperand::cast(output)->virtual_register();
+        operands_map_[vreg] = new_node;
+        new_node->AddDefinedValue(GetRegisterClass(vreg));
       } else if (output->IsConstant()) {
         operands_map_[ConstantOperand::cast(output)->virtual_register()] =
             new_node;
@@ -229,6 +259,7 @@ void InstructionScheduler::Schedule() {
 
     if (candidate != nullptr) {
       sequence()->AddInstruction(candidate->instruction());
+      UpdateRegisterPressure(candidate);
 
       for (ScheduleGraphNode* successor : candidate->successors()) {
         successor->DropUnscheduledPredecessor();
@@ -247,6 +278,8 @@ void InstructionScheduler::Schedule() {
   // Reset own state.
   graph_.clear();
   operands_map_.clear();
+  live_values_count_[kGeneralRegisters] = 0;
+  live_values_count_[kFPRegisters] = 0;
   pending_loads_.clear();
   last_deopt_or_trap_ = nullptr;
   last_live_in_reg_marker_ = nullptr;
@@ -393,6 +426,54 @@ int InstructionScheduler::GetInstructionFlags(const Instruction* instr) const {
   UNREACHABLE();
 }
 
+InstructionScheduler::RegisterClass InstructionScheduler::GetRegisterClass(
+    int vreg) const {
+  return IsFloatingPoint(sequence_->GetRepresentation(vreg))
+             ? kFPRegisters
+             : kGeneralRegisters;
+}
+
+int InstructionScheduler::RegisterPressureDelta(
+    ScheduleGraphNode* node, RegisterClass reg_class) const {
+  int delta = node->defined_values_count(reg_class);
+  for (ScheduleGraphNode* input : node->value_inputs()) {
+    // {node} is the last use of the values of {input}.
+    if (input->unscheduled_uses_count() == 1) {
+      delta -= input->defined_values_count(reg_class);
+    }
+  }
+  return delta;
+}
+
+int InstructionScheduler::HighRegisterPressureDelta(
+    ScheduleGraphNode* node) const {
+  int delta = 0;
+  for (int i = 0; i < kNumRegisterClasses; i++) {
+    RegisterClass reg_class = static_cast<RegisterClass>(i);
+    if (IsRegisterPressureHigh(reg_class)) {
+      delta += RegisterPressureDelta(node, reg_class);
+    }
+  }
+  return delta;
+}
+
+void InstructionScheduler::UpdateRegisterPressure(ScheduleGraphNode* node) {
+  for (int i = 0; i < kNumRegisterClasses; i++) {
+    // Values without uses in the block are live until its end.
+    live_values_count_[i] +=
+        node->defined_values_count(static_cast<RegisterClass>(i));
+  }
+  for (ScheduleGraphNode* input : node->value_inputs()) {
+    input->DropUnscheduledUse();
+    if (input->unscheduled_uses_count() == 0) {
+      for (int i = 0; i < kNumRegisterClasses; i++) {
+        live_values_count_[i] -=
+            input->defined_values_count(static_cast<RegisterClass>(i));
+      }
+    }
+  }
+}
+
 void InstructionScheduler::ComputeTotalLatencies() {
   for (ScheduleGraphNode* node : base::Reversed(graph_)) {
     int max_latency = 0;
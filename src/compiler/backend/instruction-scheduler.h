@@ -5,6 +5,8 @@
 #ifndef V8_COMPILER_BACKEND_INSTRUCTION_SCHEDULER_H_
 #define V8_COMPILER_BACKEND_INSTRUCTION_SCHEDULER_H_
 
+#include <algorithm>
+
 #include "src/base/optional.h"
 #include "src/base/utils/random-number-generator.h"
 #include "src/compiler/backend/instruction.h"
@@ -45,6 +47,10 @@ class InstructionScheduler final : public ZoneObject {
   static bool SchedulerSupported();
 
  private:
+  // The register pressure is tracked separately for general registers and for
+  // floating-point and SIMD registers.
+  enum RegisterClass { kGeneralRegisters, kFPRegisters, kNumRegisterClasses };
+
   // A scheduling graph node.
   // Represent an instruction and their dependencies.
   class ScheduleGraphNode : public ZoneObject {
@@ -67,10 +73,41 @@ class InstructionScheduler final : public ZoneObject {
       unscheduled_predecessors_count_--;
     }
 
+    // Record that the current instruction uses a value defined by 'node'.
+    // Each defining node is only recorded once, even if several inputs use
+    // its values.
+    void AddValueInput(ScheduleGraphNode* node) {
+      if (std::find(value_inputs_.begin(), value_inputs_.end(), node) !=
+          value_inputs_.end()) {
+        return;
+      }
+      value_inputs_.push_back(node);
+      node->unscheduled_uses_count_++;
+    }
+
+    // Record that the current instruction defines a value which needs a
+    // register of the given class.
+    void AddDefinedValue(RegisterClass reg_class) {
+      defined_values_count_[reg_class]++;
+    }
+
+    // Record that we have scheduled one of the uses of the values defined by
+    // this instruction.
+    void DropUnscheduledUse() {
+      DCHECK_LT(0, unscheduled_uses_count_);
+      unscheduled_uses_count_--;
+    }
+
     Instruction* instruction() { return instr_; }
     ZoneDeque<ScheduleGraphNode*>& successors() { return successors_; }
+    ZoneVector<ScheduleGraphNode*>& value_inputs() { return value_inputs_; }
     int latency() const { return latency_; }
 
+    int defined_values_count(RegisterClass reg_class) const {
+      return defined_values_count_[reg_class];
+    }
+    int unscheduled_uses_count() const { return unscheduled_uses_count_; }
+
     int total_latency() const { return total_latency_; }
     void set_total_latency(int latency) { total_latency_ = latency; }
 
@@ -81,9 +118,19 @@ class InstructionScheduler final : public ZoneObject {
     Instruction* instr_;
     ZoneDeque<ScheduleGraphNode*> successors_;
 
+    // The nodes of the block defining the values used by this instruction.
+    ZoneVector<ScheduleGraphNode*> value_inputs_;
+
     // Number of unscheduled predecessors for this node.
     int unscheduled_predecessors_count_;
 
+    // Number of virtual registers of each class defined by this instruction,
+    // and number of unscheduled instructions of the block using them. These
+    // values need a register from the time this instruction is scheduled until
+    // all their uses are.
+    int defined_values_count_[kNumRegisterClasses];
+    int unscheduled_uses_count_;
+
     // Estimate of the instruction latency (the number of cycles it takes for
     // instruction to complete).
     int latency_;
@@ -119,7 +166,8 @@ class InstructionScheduler final : public ZoneObject {
 
   // A scheduling queue which prioritize nodes on the critical path (we look
   // for the instruction with the highest latency on the path to reach the end
-  // of the graph).
+  // of the graph). When the register pressure is high, instructions which
+  // free registers are preferred instead, to avoid introducing spills.
   class CriticalPathFirstQueue : public SchedulingQueueBase {
    public:
     explicit CriticalPathFirstQueue(InstructionScheduler* scheduler)
@@ -206,6 +254,23 @@ class InstructionScheduler final : public ZoneObject {
 
   void ComputeTotalLatencies();
 
+  RegisterClass GetRegisterClass(int vreg) const;
+
+  // Estimate of the variation of the number of live values of the given class
+  // if the given node was scheduled next.
+  int RegisterPressureDelta(ScheduleGraphNode* node,
+                            RegisterClass reg_class) const;
+  // Sum of the above for the classes whose pressure is high.
+  int HighRegisterPressureDelta(ScheduleGraphNode* node) const;
+  void UpdateRegisterPressure(ScheduleGraphNode* node);
+  bool IsRegisterPressureHigh(RegisterClass reg_class) const {
+    return live_values_count_[reg_class] >= register_pressure_limit_[reg_class];
+  }
+  bool IsRegisterPressureHigh() const {
+    return IsRegisterPressureHigh(kGeneralRegisters) ||
+           IsRegisterPressureHigh(kFPRegisters);
+  }
+
   static int GetInstructionLatency(const Instruction* instr);
 
   Zone* zone() { return zone_; }
@@ -243,6 +308,12 @@ class InstructionScheduler final : public ZoneObject {
   // record operand dependencies in the scheduling graph.
   ZoneMap<int32_t, ScheduleGraphNode*> operands_map_;
 
+  // Number of values of each class defined by the instructions scheduled so
+  // far which are still live, and the number of allocatable registers of each
+  // class, above which the scheduler tries to reduce it.
+  int live_values_count_[kNumRegisterClasses];
+  int register_pressure_limit_[kNumRegisterClasses];
+
   base::Optional<base::RandomNumberGenerator> random_number_generator_;
 };
 
@@ -307,8 +307,11 @@ class TopTierRegisterAllocationData final : public RegisterAllocationData {
   // Creates a new live range.
   TopLevelLiveRange* NewLiveRange(int index, MachineRepresentation rep);
 
+  // Allocates the spill range (if needed) in {zone}, which defaults to
+  // allocation_zone().
   SpillRange* AssignSpillRangeToLiveRange(TopLevelLiveRange* range,
-                                          SpillMode spill_mode);
+                                          SpillMode spill_mode,
+                                          Zone* zone = nullptr);
   SpillRange* CreateSpillRangeForLiveRange(TopLevelLiveRange* range);
 
   MoveOperands* AddGapMove(int index, Instruction::GapPosition position,
@@ -333,22 +336,6 @@ class TopTierRegisterAllocationData final : public RegisterAllocationData {
     return preassigned_slot_ranges_;
   }
 
-  void RememberSpillState(RpoNumber block,
-                          const ZoneVector<LiveRange*>& state) {
-    spill_state_[block.ToSize()] = state;
-  }
-
-  ZoneVector<LiveRange*>& GetSpillState(RpoNumber block) {
-    auto& result = spill_state_[block.ToSize()];
-    return result;
-  }
-
-  void ResetSpillState() {
-    for (auto& state : spill_state_) {
-      state.clear();
-    }
-  }
-
   TickCounter* tick_counter() { return tick_counter_; }
 
   ZoneMap<TopLevelLiveRange*, AllocatedOperand*>& slot_for_const_range() {
@@ -379,7 +366,6 @@ class TopTierRegisterAllocationData final : public RegisterAllocationData {
   BitVector* fixed_simd128_register_use_;
   int virtual_register_count_;
   RangesWithPreassignedSlots preassigned_slot_ranges_;
-  ZoneVector<ZoneVector<LiveRange*>> spill_state_;
   RegisterAllocationFlags flags_;
   TickCounter* const tick_counter_;
   ZoneMap<TopLevelLiveRange*, AllocatedOperand*> slot_for_const_range_;
@@ -1312,7 +1298,8 @@ class BundleBuilder final : public ZoneObject {
 
 class RegisterAllocator : public ZoneObject {
  public:
-  RegisterAllocator(TopTierRegisterAllocationData* data, RegisterKind kind);
+  RegisterAllocator(TopTierRegisterAllocationData* data, RegisterKind kind,
+                    Zone* allocation_zone, TickCounter* tick_counter);
   RegisterAllocator(const RegisterAllocator&) = delete;
   RegisterAllocator& operator=(const RegisterAllocator&) = delete;
 
@@ -1333,7 +1320,11 @@ class RegisterAllocator : public ZoneObject {
   LifetimePosition GetSplitPositionForInstruction(const LiveRange* range,
                                                   int instruction_index);
 
-  Zone* allocation_zone() const { return data()->allocation_zone(); }
+  // The zone in which the live ranges and spill ranges created by the
+  // allocator are allocated. It differs from the allocation zone of {data()}
+  // when the register kinds are allocated concurrently.
+  Zone* allocation_zone() const { return allocation_zone_; }
+  TickCounter* tick_counter() const { return tick_counter_; }
 
   // Find the optimal split for ranges defined by a memory operand, e.g.
   // constants or function parameters passed on the stack.
@@ -1375,6 +1366,8 @@ class RegisterAllocator : public ZoneObject {
 
  private:
   TopTierRegisterAllocationData* const data_;
+  Zone* const allocation_zone_;
+  TickCounter* const tick_counter_;
   const RegisterKind mode_;
   const int num_registers_;
   int num_allocatable_registers_;
@@ -1389,6 +1382,13 @@ class LinearScanAllocator final : public RegisterAllocator {
  public:
   LinearScanAllocator(TopTierRegisterAllocationData* data, RegisterKind kind,
                       Zone* local_zone);
+  // Allocates the registers of {kind} without allocating in the zone of
+  // {data} nor using its tick counter, so that the different register kinds
+  // can be allocated concurrently. The live ranges resulting from splits are
+  // allocated in {allocation_zone}, which must thus live as long as {data}.
+  LinearScanAllocator(TopTierRegisterAllocationData* data, RegisterKind kind,
+                      Zone* local_zone, Zone* allocation_zone,
+                      TickCounter* tick_counter);
   LinearScanAllocator(const LinearScanAllocator&) = delete;
   LinearScanAllocator& operator=(const LinearScanAllocator&) = delete;
 
@@ -1532,9 +1532,21 @@ class LinearScanAllocator final : public RegisterAllocator {
 
   void PrintRangeOverview();
 
+  void RememberSpillState(RpoNumber block,
+                          const ZoneVector<LiveRange*>& state) {
+    spill_state_[block.ToSize()] = state;
+  }
+
+  ZoneVector<LiveRange*>& GetSpillState(RpoNumber block) {
+    return spill_state_[block.ToSize()];
+  }
+
   UnhandledLiveRangeQueue unhandled_live_ranges_;
   ZoneVector<LiveRange*> active_live_ranges_;
   ZoneVector<InactiveLiveRangeQueue> inactive_live_ranges_;
+  // The active ranges at the end of each block, used to compute the state at
+  // the beginning of their successors.
+  ZoneVector<ZoneVector<LiveRange*>> spill_state_;
 
   // Approximate at what position the set of ranges will change next.
   // Used to avoid scanning for updates even if none are present.
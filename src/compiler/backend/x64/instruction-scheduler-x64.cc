@@ -2,7 +2,11 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <cstring>
+
+#include "src/base/cpu.h"
 #include "src/compiler/backend/instruction-scheduler.h"
+#include "src/flags/flags.h"
 
 namespace v8 {
 namespace internal {
@@ -453,18 +457,156 @@ int InstructionScheduler::GetTargetInstructionFlags(
   UNREACHABLE();
 }
 
-int InstructionScheduler::GetInstructionLatency(const Instruction* instr) {
-  // Basic latency modeling for x64 instructions. They have been determined
-  // in an empirical way.
+namespace {
+
+// Latencies, in cycles, of the main classes of instructions on a family of
+// microarchitectures. The scheduler issues at most one instruction per cycle,
+// so the throughput of the execution ports is not modeled.
+struct LatencyModel {
+  // Added to the latency of instructions with a memory input.
+  int memory_operand;
+  int imul;
+  int idiv32;
+  int idiv64;
+  int udiv32;
+  int udiv64;
+  // Add, sub, min, max, abs, neg and comparisons, scalar or packed.
+  int fp_add;
+  int float32_mul;
+  int float64_mul;
+  int float32_div;
+  int float64_div;
+  int float32_sqrt;
+  int float64_sqrt;
+  // Conversions between floating-point formats or to int32, and rounding.
+  int fp_convert;
+  int i16x8_mul;
+  int i32x4_mul;
+};
+
+// Latencies for CPUs without a specific model, which have been determined in
+// an empirical way.
+constexpr LatencyModel kGenericModel = {
+    /* memory_operand */ 0,
+    /* imul */ 3,
+    /* idiv32 */ 35,
+    /* idiv64 */ 49,
+    /* udiv32 */ 26,
+    /* udiv64 */ 38,
+    /* fp_add */ 3,
+    /* float32_mul */ 4,
+    /* float64_mul */ 5,
+    /* float32_div */ 13,
+    /* float64_div */ 13,
+    /* float32_sqrt */ 13,
+    /* float64_sqrt */ 13,
+    /* fp_convert */ 4,
+    /* i16x8_mul */ 5,
+    /* i32x4_mul */ 10,
+};
+
+// Intel Core microarchitectures since Skylake.
+constexpr LatencyModel kIntelCoreModel = {
+    /* memory_operand */ 4,
+    /* imul */ 3,
+    /* idiv32 */ 26,
+    /* idiv64 */ 42,
+    /* udiv32 */ 26,
+    /* udiv64 */ 35,
+    /* fp_add */ 4,
+    /* float32_mul */ 4,
+    /* float64_mul */ 4,
+    /* float32_div */ 11,
+    /* float64_div */ 14,
+    /* float32_sqrt */ 12,
+    /* float64_sqrt */ 18,
+    /* fp_convert */ 5,
+    /* i16x8_mul */ 5,
+    /* i32x4_mul */ 10,
+};
+
+// AMD Zen microarchitectures.
+constexpr LatencyModel kAmdZenModel = {
+    /* memory_operand */ 3,
+    /* imul */ 3,
+    /* idiv32 */ 20,
+    /* idiv64 */ 30,
+    /* udiv32 */ 18,
+    /* udiv64 */ 28,
+    /* fp_add */ 3,
+    /* float32_mul */ 3,
+    /* float64_mul */ 3,
+    /* float32_div */ 10,
+    /* float64_div */ 13,
+    /* float32_sqrt */ 14,
+    /* float64_sqrt */ 20,
+    /* fp_convert */ 4,
+    /* i16x8_mul */ 3,
+    /* i32x4_mul */ 4,
+};
+
+// Returns whether the family 6 display model is an Intel Core
+// microarchitecture since Skylake.
+bool IsIntelCoreSinceSkylake(int model) {
+  switch (model) {
+    case 0x4E:  // Skylake (mobile)
+    case 0x5E:  // Skylake (desktop)
+    case 0x55:  // Skylake-X, Cascade Lake, Cooper Lake
+    case 0x8E:  // Kaby Lake, Coffee Lake, Whiskey Lake (mobile)
+    case 0x9E:  // Kaby Lake, Coffee Lake (desktop)
+    case 0xA5:  // Comet Lake
+    case 0xA6:  // Comet Lake (mobile)
+    case 0x66:  // Cannon Lake
+    case 0x7D:  // Ice Lake (desktop)
+    case 0x7E:  // Ice Lake (mobile)
+    case 0x6A:  // Ice Lake-SP
+    case 0x6C:  // Ice Lake-D
+    case 0x8C:  // Tiger Lake (mobile)
+    case 0x8D:  // Tiger Lake (desktop)
+    case 0xA7:  // Rocket Lake
+    case 0x97:  // Alder Lake
+    case 0x9A:  // Alder Lake (mobile)
+    case 0xB7:  // Raptor Lake
+    case 0xBA:  // Raptor Lake (mobile)
+    case 0xBF:  // Raptor Lake
+    case 0x8F:  // Sapphire Rapids
+    case 0xCF:  // Emerald Rapids
+    case 0xAA:  // Meteor Lake
+    case 0xAC:  // Meteor Lake
+      return true;
+    default:
+      return false;
+  }
+}
+
+const LatencyModel& GetLatencyModel() {
+  static const LatencyModel& model = []() -> const LatencyModel& {
+    // Builtins are scheduled when creating the snapshot, which should not
+    // depend on the host.
+    if (v8_flags.predictable) return kGenericModel;
+    base::CPU cpu;
+    if (strcmp(cpu.vendor(), "GenuineIntel") == 0 && cpu.family() == 0x6 &&
+        IsIntelCoreSinceSkylake(cpu.model())) {
+      return kIntelCoreModel;
+    }
+    if (strcmp(cpu.vendor(), "AuthenticAMD") == 0 && cpu.family() == 0xF &&
+        cpu.ext_family() >= 0x8) {
+      return kAmdZenModel;
+    }
+    return kGenericModel;
+  }();
+  return model;
+}
+
+int GetOperationLatency(const LatencyModel& model, const Instruction* instr) {
   switch (instr->arch_opcode()) {
-    case kSSEFloat64Mul:
-      return 5;
     case kX64Imul:
     case kX64Imul32:
     case kX64ImulHigh32:
     case kX64UmulHigh32:
     case kX64ImulHigh64:
     case kX64UmulHigh64:
+      return model.imul;
     case kX64Float32Abs:
     case kX64Float32Neg:
     case kX64Float64Abs:
@@ -477,8 +619,27 @@ int InstructionScheduler::GetInstructionLatency(const Instruction* instr) {
     case kSSEFloat64Sub:
     case kSSEFloat64Max:
     case kSSEFloat64Min:
-      return 3;
+    case kAVXFloat32Cmp:
+    case kAVXFloat32Add:
+    case kAVXFloat32Sub:
+    case kAVXFloat64Cmp:
+    case kAVXFloat64Add:
+    case kAVXFloat64Sub:
+    case kX64F32x4Add:
+    case kX64F32x4Sub:
+    case kX64F32x4Min:
+    case kX64F32x4Max:
+    case kX64F64x2Add:
+    case kX64F64x2Sub:
+      return model.fp_add;
     case kSSEFloat32Mul:
+    case kAVXFloat32Mul:
+    case kX64F32x4Mul:
+      return model.float32_mul;
+    case kSSEFloat64Mul:
+    case kAVXFloat64Mul:
+    case kX64F64x2Mul:
+      return model.float64_mul;
     case kSSEFloat32ToFloat64:
     case kSSEFloat64ToFloat32:
     case kSSEFloat32Round:
@@ -487,20 +648,35 @@ int InstructionScheduler::GetInstructionLatency(const Instruction* instr) {
     case kSSEFloat32ToUint32:
     case kSSEFloat64ToInt32:
     case kSSEFloat64ToUint32:
-      return 4;
+      return model.fp_convert;
     case kX64Idiv:
-      return 49;
+      return model.idiv64;
     case kX64Idiv32:
-      return 35;
+      return model.idiv32;
     case kX64Udiv:
-      return 38;
+      return model.udiv64;
     case kX64Udiv32:
-      return 26;
+      return model.udiv32;
     case kSSEFloat32Div:
+    case kAVXFloat32Div:
+    case kX64F32x4Div:
+      return model.float32_div;
     case kSSEFloat64Div:
+    case kAVXFloat64Div:
+    case kX64F64x2Div:
+      return model.float64_div;
     case kSSEFloat32Sqrt:
+    case kX64F32x4Sqrt:
+      return model.float32_sqrt;
     case kSSEFloat64Sqrt:
-      return 13;
+    case kX64F64x2Sqrt:
+      return model.float64_sqrt;
+    case kX64I16x8Mul:
+      return model.i16x8_mul;
+    case kX64I32x4Mul:
+      return model.i32x4_mul;
+    // The following are sequences of instructions, whose latency does not
+    // depend much on the microarchitecture.
     case kSSEFloat32ToInt64:
     case kSSEFloat64ToInt64:
     case kSSEFloat32ToUint64:
@@ -515,6 +691,23 @@ int InstructionScheduler::GetInstructionLatency(const Instruction* instr) {
   }
 }
 
+}  // namespace
+
+int InstructionScheduler::GetInstructionLatency(const Instruction* instr) {
+  // The latencies of x64 instructions depend on the microarchitecture of the
+  // host, which is detected on first use.
+  const LatencyModel& model = GetLatencyModel();
+  int latency = GetOperationLatency(model, instr);
+  // Account for the latency of the load of memory inputs. Stores and
+  // read-modify-write instructions don't have outputs, and {lea} doesn't
+  // access memory.
+  if (instr->addressing_mode() != kMode_None && instr->OutputCount() > 0 &&
+      instr->arch_opcode() != kX64Lea && instr->arch_opcode() != kX64Lea32) {
+    latency += model.memory_operand;
+  }
+  return latency;
+}
+
 }  // namespace compiler
 }  // namespace internal
 }  // namespace v8
@@ -4,12 +4,14 @@
 
 #include "src/compiler/pipeline.h"
 
+#include <atomic>
 #include <fstream>
 #include <iostream>
 #include <memory>
 #include <sstream>
 
 #include "src/base/optional.h"
+#include "src/base/small-vector.h"
 #include "src/builtins/profile-data-reader.h"
 #include "src/codegen/assembler-inl.h"
 #include "src/codegen/bailout-reason.h"
@@ -87,6 +89,9 @@
 #include "src/compiler/turboshaft/graph-visualizer.h"
 #include "src/compiler/turboshaft/graph.h"
 #include "src/compiler/turboshaft/late-escape-analysis-reducer.h"
+#include "src/compiler/turboshaft/load-elimination-reducer.h"
+#include "src/compiler/turboshaft/loop-peeling-reducer.h"
+#include "src/compiler/turboshaft/loop-unrolling-reducer.h"
 #include "src/compiler/turboshaft/machine-optimization-reducer.h"
 #include "src/compiler/turboshaft/memory-optimization.h"
 #include "src/compiler/turboshaft/optimization-phase.h"
@@ -108,6 +113,7 @@
 #include "src/execution/isolate-inl.h"
 #include "src/flags/flags.h"
 #include "src/heap/local-heap.h"
+#include "src/heap/parked-scope.h"
 #include "src/logging/code-events.h"
 #include "src/logging/counters.h"
 #include "src/logging/runtime-call-stats-scope.h"
@@ -519,8 +525,20 @@ class PipelineData {
     frame_ = nullptr;
   }
 
+  // Returns a new zone that is destroyed together with the register allocation
+  // zone. Zones are not thread-safe: this is used to give each thread of the
+  // parallel register allocation its own zone.
+  Zone* NewRegisterAllocationZone() {
+    DCHECK_NOT_NULL(register_allocation_zone_);
+    additional_register_allocation_zone_scopes_.push_back(
+        std::make_unique<ZoneStats::Scope>(zone_stats_,
+                                           kRegisterAllocationZoneName));
+    return additional_register_allocation_zone_scopes_.back()->zone();
+  }
+
   void DeleteRegisterAllocationZone() {
     if (register_allocation_zone_ == nullptr) return;
+    additional_register_allocation_zone_scopes_.clear();
     register_allocation_zone_scope_.Destroy();
     register_allocation_zone_ = nullptr;
     register_allocation_data_ = nullptr;
@@ -688,6 +706,8 @@ class PipelineData {
   ZoneStats::Scope register_allocation_zone_scope_;
   Zone* register_allocation_zone_;
   RegisterAllocationData* register_allocation_data_ = nullptr;
+  std::vector<std::unique_ptr<ZoneStats::Scope>>
+      additional_register_allocation_zone_scopes_;
 
   // Source position output for --trace-turbo.
   std::string source_position_output_;
@@ -1198,7 +1218,10 @@ PipelineCompilationJob::Status PipelineCompilationJob::PrepareJobImpl(
   if (!v8_flags.always_turbofan) {
     compilation_info()->set_bailout_on_uninitialized();
   }
-  if (v8_flags.turbo_loop_peeling) {
+  // When Turboshaft peels loops, TurboFan doesn't, so that loops are not
+  // peeled twice.
+  if (v8_flags.turbo_loop_peeling &&
+      !(v8_flags.turboshaft && v8_flags.turboshaft_loop_peeling)) {
     compilation_info()->set_loop_peeling();
   }
   if (v8_flags.turbo_inlining) {
@@ -1730,7 +1753,8 @@ struct WasmLoopPeelingPhase {
   DECL_PIPELINE_PHASE_CONSTANTS(WasmLoopPeeling)
 
   void Run(PipelineData* data, Zone* temp_zone,
-           std::vector<compiler::WasmLoopInfo>* loop_infos) {
+           std::vector<compiler::WasmLoopInfo>* loop_infos,
+           bool unroll_later) {
     AllNodes all_nodes(temp_zone, data->graph());
     for (WasmLoopInfo& loop_info : *loop_infos) {
       if (loop_info.can_be_innermost) {
@@ -1744,7 +1768,7 @@ struct WasmLoopPeelingPhase {
       }
     }
     // If we are going to unroll later, keep loop exits.
-    if (!v8_flags.wasm_loop_unrolling) EliminateLoopExits(loop_infos);
+    if (!unroll_later) EliminateLoopExits(loop_infos);
   }
 };
 #endif  // V8_ENABLE_WEBASSEMBLY
@@ -1967,7 +1991,8 @@ struct LateOptimizationPhase {
     if (data->HasTurboshaftGraph()) {
       // TODO(dmercadier,tebbi): add missing CommonOperatorReducer.
       turboshaft::OptimizationPhase<
-          turboshaft::VariableReducer, turboshaft::BranchEliminationReducer,
+          turboshaft::VariableReducer, turboshaft::LoadEliminationReducer,
+          turboshaft::BranchEliminationReducer,
           turboshaft::SelectLoweringReducer,
           turboshaft::MachineOptimizationReducerSignallingNanImpossible,
           turboshaft::ValueNumberingReducer>::Run(&data->turboshaft_graph(),
@@ -2088,6 +2113,38 @@ struct BuildTurboshaftPhase {
   }
 };
 
+struct TurboshaftLoopPeelingPhase {
+  DECL_PIPELINE_PHASE_CONSTANTS(TurboshaftLoopPeeling)
+
+  void Run(PipelineData* data, Zone* temp_zone) {
+    UnparkedScopeIfNeeded scope(data->broker(),
+                                v8_flags.turboshaft_trace_reduction);
+    turboshaft::OptimizationPhase<
+        turboshaft::LoopPeelingReducer, turboshaft::VariableReducer,
+        turboshaft::BranchEliminationReducer,
+        turboshaft::MachineOptimizationReducerSignallingNanImpossible,
+        turboshaft::ValueNumberingReducer>::Run(&data->turboshaft_graph(),
+                                                temp_zone,
+                                                data->node_origins());
+  }
+};
+
+struct TurboshaftLoopUnrollingPhase {
+  DECL_PIPELINE_PHASE_CONSTANTS(TurboshaftLoopUnrolling)
+
+  void Run(PipelineData* data, Zone* temp_zone) {
+    UnparkedScopeIfNeeded scope(data->broker(),
+                                v8_flags.turboshaft_trace_reduction);
+    turboshaft::OptimizationPhase<
+        turboshaft::LoopUnrollingReducer, turboshaft::VariableReducer,
+        turboshaft::BranchEliminationReducer,
+        turboshaft::MachineOptimizationReducerSignallingNanImpossible,
+        turboshaft::ValueNumberingReducer>::Run(&data->turboshaft_graph(),
+                                                temp_zone,
+                                                data->node_origins());
+  }
+};
+
 struct OptimizeTurboshaftPhase {
   DECL_PIPELINE_PHASE_CONSTANTS(OptimizeTurboshaft)
 
@@ -2507,6 +2564,94 @@ struct AllocateSimd128RegistersPhase {
   }
 };
 
+// Allocates the registers of several register kinds concurrently. The live
+// ranges (and thus the bundles and spill ranges) of the different kinds are
+// disjoint, and each LinearScanAllocator only allocates in its own zones, so
+// that the allocators only share read-only state.
+class AllocateRegistersJob final : public JobTask {
+ public:
+  struct Item {
+    RegisterKind kind;
+    // The zone for the live ranges created by splitting, which must live as
+    // long as the register allocation data.
+    Zone* allocation_zone;
+    Zone* temp_zone;
+  };
+
+  AllocateRegistersJob(TopTierRegisterAllocationData* data,
+                       TickCounter* tick_counter,
+                       base::Vector<const Item> items)
+      : data_(data), tick_counter_(tick_counter), items_(items) {}
+
+  void Run(JobDelegate* delegate) override {
+    while (true) {
+      size_t index = next_item_.fetch_add(1, std::memory_order_relaxed);
+      if (index >= items_.size()) return;
+      const Item& item = items_[index];
+      // The tick counter of the compilation may enter a safepoint on behalf of
+      // the compilation thread, so other threads use their own.
+      TickCounter local_tick_counter;
+      LinearScanAllocator allocator(
+          data_, item.kind, item.temp_zone, item.allocation_zone,
+          delegate->IsJoiningThread() ? tick_counter_ : &local_tick_counter);
+      allocator.AllocateRegisters();
+    }
+  }
+
+  size_t GetMaxConcurrency(size_t /* worker_count */) const override {
+    size_t next_item = next_item_.load(std::memory_order_relaxed);
+    return items_.size() - std::min(next_item, items_.size());
+  }
+
+ private:
+  TopTierRegisterAllocationData* const data_;
+  TickCounter* const tick_counter_;
+  const base::Vector<const Item> items_;
+  std::atomic<size_t> next_item_{0};
+};
+
+struct AllocateRegistersInParallelPhase {
+  DECL_PIPELINE_PHASE_CONSTANTS(AllocateRegistersInParallel)
+
+  void Run(PipelineData* data, Zone* temp_zone,
+           base::Vector<const RegisterKind> kinds) {
+    DCHECK(!v8_flags.single_threaded);
+    // The first kind uses the zones of the pipeline, and the other ones new
+    // zones, all created here since ZoneStats isn't thread-safe.
+    std::vector<std::unique_ptr<ZoneStats::Scope>> temp_zone_scopes;
+    std::vector<AllocateRegistersJob::Item> items;
+    for (RegisterKind kind : kinds) {
+      if (items.empty()) {
+        items.push_back({kind, data->register_allocation_zone(), temp_zone});
+        continue;
+      }
+      temp_zone_scopes.push_back(
+          std::make_unique<ZoneStats::Scope>(data->zone_stats(), ZONE_NAME));
+      items.push_back({kind, data->NewRegisterAllocationZone(),
+                       temp_zone_scopes.back()->zone()});
+    }
+
+    // Park while joining so that the compilation thread doesn't hold up a GC
+    // safepoint while it waits for the other threads. Register allocation
+    // doesn't access the heap, and safepoint checks of the tick counter are
+    // no-ops while parked.
+    base::Optional<ParkedScope> parked_scope;
+    if (data->broker() != nullptr) {
+      LocalIsolate* local_isolate = data->broker()->local_isolate();
+      if (local_isolate != nullptr && !local_isolate->heap()->IsParked()) {
+        parked_scope.emplace(local_isolate);
+      }
+    }
+    V8::GetCurrentPlatform()
+        ->CreateJob(TaskPriority::kUserBlocking,
+                    std::make_unique<AllocateRegistersJob>(
+                        data->top_tier_register_allocation_data(),
+                        &data->info()->tick_counter(),
+                        base::VectorOf(items)))
+        ->Join();
+  }
+};
+
 struct DecideSpillingModePhase {
   DECL_PIPELINE_PHASE_CONSTANTS(DecideSpillingMode)
 
@@ -3084,6 +3229,16 @@ bool PipelineImpl::OptimizeGraph(Linkage* linkage) {
 
     Run<PrintTurboshaftGraphPhase>(BuildTurboshaftPhase::phase_name());
 
+    if (v8_flags.turboshaft_loop_peeling) {
+      Run<TurboshaftLoopPeelingPhase>();
+      Run<PrintTurboshaftGraphPhase>(TurboshaftLoopPeelingPhase::phase_name());
+    }
+    if (v8_flags.turboshaft_loop_unrolling) {
+      Run<TurboshaftLoopUnrollingPhase>();
+      Run<PrintTurboshaftGraphPhase>(
+          TurboshaftLoopUnrollingPhase::phase_name());
+    }
+
     Run<LateOptimizationPhase>();
     Run<PrintTurboshaftGraphPhase>(LateOptimizationPhase::phase_name());
 
@@ -3464,13 +3619,26 @@ void Pipeline::GenerateCodeForWasmFunction(
                                     loop_info);
     pipeline.RunPrintAndVerify(WasmInliningPhase::phase_name(), true);
   }
-  if (v8_flags.wasm_loop_peeling) {
-    pipeline.Run<WasmLoopPeelingPhase>(loop_info);
+  // When Turboshaft peels or unrolls loops, TurboFan doesn't, so that loops
+  // are not transformed twice. The graph builder emitted loop exits for the
+  // TurboFan passes though, which then need to be removed.
+  const bool loop_peeling =
+      v8_flags.wasm_loop_peeling &&
+      !(v8_flags.turboshaft_wasm && v8_flags.turboshaft_loop_peeling);
+  const bool loop_unrolling =
+      v8_flags.wasm_loop_unrolling &&
+      !(v8_flags.turboshaft_wasm && v8_flags.turboshaft_loop_unrolling);
+  if (loop_peeling) {
+    pipeline.Run<WasmLoopPeelingPhase>(loop_info, loop_unrolling);
     pipeline.RunPrintAndVerify(WasmLoopPeelingPhase::phase_name(), true);
   }
-  if (v8_flags.wasm_loop_unrolling) {
+  if (loop_unrolling) {
     pipeline.Run<WasmLoopUnrollingPhase>(loop_info);
     pipeline.RunPrintAndVerify(WasmLoopUnrollingPhase::phase_name(), true);
+  } else if (!loop_peeling &&
+             (v8_flags.wasm_loop_peeling || v8_flags.wasm_loop_unrolling)) {
+    pipeline.Run<LoopExitEliminationPhase>();
+    pipeline.RunPrintAndVerify(LoopExitEliminationPhase::phase_name(), true);
   }
   const bool is_asm_js = is_asmjs_module(module);
   MachineOperatorReducer::SignallingNanPropagation signalling_nan_propagation =
@@ -3553,6 +3721,17 @@ void Pipeline::GenerateCodeForWasmFunction(
     }
     pipeline.Run<PrintTurboshaftGraphPhase>(BuildTurboshaftPhase::phase_name());
 
+    if (v8_flags.turboshaft_loop_peeling) {
+      pipeline.Run<TurboshaftLoopPeelingPhase>();
+      pipeline.Run<PrintTurboshaftGraphPhase>(
+          TurboshaftLoopPeelingPhase::phase_name());
+    }
+    if (v8_flags.turboshaft_loop_unrolling) {
+      pipeline.Run<TurboshaftLoopUnrollingPhase>();
+      pipeline.Run<PrintTurboshaftGraphPhase>(
+          TurboshaftLoopUnrollingPhase::phase_name());
+    }
+
     pipeline.Run<OptimizeTurboshaftPhase>();
     pipeline.Run<PrintTurboshaftGraphPhase>(
         OptimizeTurboshaftPhase::phase_name());
@@ -4146,15 +4325,32 @@ void PipelineImpl::AllocateRegistersForTopTier(
         "PreAllocation", data->top_tier_register_allocation_data());
   }
 
-  Run<AllocateGeneralRegistersPhase<LinearScanAllocator>>();
-
+  base::SmallVector<RegisterKind, 3> kinds = {RegisterKind::kGeneral};
   if (data->sequence()->HasFPVirtualRegisters()) {
-    Run<AllocateFPRegistersPhase<LinearScanAllocator>>();
+    kinds.push_back(RegisterKind::kDouble);
   }
-
   if (data->sequence()->HasSimd128VirtualRegisters() &&
       (kFPAliasing == AliasingKind::kIndependent)) {
-    Run<AllocateSimd128RegistersPhase<LinearScanAllocator>>();
+    kinds.push_back(RegisterKind::kSimd128);
+  }
+
+  if (v8_flags.turbo_parallel_register_allocation && kinds.size() > 1 &&
+      !data->info()->trace_turbo_allocation()) {
+    Run<AllocateRegistersInParallelPhase>(base::VectorOf(kinds));
+  } else {
+    for (RegisterKind kind : kinds) {
+      switch (kind) {
+        case RegisterKind::kGeneral:
+          Run<AllocateGeneralRegistersPhase<LinearScanAllocator>>();
+          break;
+        case RegisterKind::kDouble:
+          Run<AllocateFPRegistersPhase<LinearScanAllocator>>();
+          break;
+        case RegisterKind::kSimd128:
+          Run<AllocateSimd128RegistersPhase<LinearScanAllocator>>();
+          break;
+      }
+    }
   }
 
   Run<DecideSpillingModePhase>();
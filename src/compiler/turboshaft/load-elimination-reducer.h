@@ -0,0 +1,405 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_COMPILER_TURBOSHAFT_LOAD_ELIMINATION_REDUCER_H_
+#define V8_COMPILER_TURBOSHAFT_LOAD_ELIMINATION_REDUCER_H_
+
+#include <algorithm>
+
+#include "src/base/functional.h"
+#include "src/base/logging.h"
+#include "src/base/optional.h"
+#include "src/compiler/turboshaft/assembler.h"
+#include "src/compiler/turboshaft/graph.h"
+#include "src/compiler/turboshaft/index.h"
+#include "src/compiler/turboshaft/loop-finder.h"
+#include "src/compiler/turboshaft/operations.h"
+#include "src/compiler/turboshaft/representations.h"
+#include "src/compiler/turboshaft/snapshot-table.h"
+#include "src/flags/flags.h"
+#include "src/zone/zone-containers.h"
+
+namespace v8::internal::compiler::turboshaft {
+
+// The memory location accessed by a Load or Store with a tagged base:
+// base + offset + index * 2^element_size_log2.
+struct MemoryAddress {
+  OpIndex base;
+  OpIndex index;
+  int32_t offset;
+  uint8_t element_size_log2;
+  MemoryRepresentation rep;
+  RegisterRepresentation result_rep;
+
+  bool operator==(const MemoryAddress& other) const {
+    return base == other.base && index == other.index &&
+           offset == other.offset &&
+           element_size_log2 == other.element_size_log2 &&
+           rep == other.rep && result_rep == other.result_rep;
+  }
+};
+
+V8_INLINE size_t hash_value(const MemoryAddress& address) {
+  return base::hash_combine(address.base, address.index, address.offset,
+                            address.element_size_log2, address.rep,
+                            address.result_rep);
+}
+
+template <class Next>
+class LoadEliminationReducer : public Next {
+  // # General overview
+  //
+  // LoadEliminationReducer replaces loads from tagged objects by a value that
+  // is already known to be stored at the loaded address: either the result of
+  // a previous load from the same address, or the value of a previous store to
+  // it. It is the Turboshaft counterpart of TurboFan's LoadElimination, but
+  // works on machine-level Loads and Stores rather than on field and element
+  // accesses.
+  //
+  // The known contents of the heap are kept in a SnapshotTable that maps
+  // memory addresses to output-graph values. Like in the VariableReducer, a
+  // Snapshot is saved for every block when the next one is bound, and the
+  // state of a block is computed from the Snapshots of its predecessors. At
+  // merges, a value is only kept if it is the same in all predecessors (we
+  // don't introduce Phis for loaded values). Since the output graph is built
+  // by visiting the dominator tree, values that survive are always defined in
+  // a dominator of the current block.
+  //
+  // # Aliasing
+  //
+  // Two accesses only alias if they are at the same offset in objects that
+  // could be the same; we don't try to prove that bases are different. We
+  // distinguish between field accesses (no index) and element accesses (with
+  // an index). The offset of an element access doesn't bound the memory that
+  // it touches: MachineOptimizationReducer folds constant additions to the
+  // index into the offset, so that `a[j + 1]` has index `j`, which can be -1.
+  // As a result:
+  //
+  //   - a field store invalidates the fields that overlap it on any base, and
+  //     all elements.
+  //   - an element store invalidates all fields and elements.
+  //
+  // Stores with an untagged base are assumed to alias everything, unless the
+  // base is an external constant (which points outside of the JS heap). Calls
+  // invalidate everything.
+  //
+  // # Loops
+  //
+  // When binding a loop header, we don't know yet what the loop body will
+  // write. Instead of running to a fixpoint, Analyze() precomputes, for every
+  // loop of the input graph, which stores (and calls) it contains, and the
+  // corresponding invalidations are applied to the state coming from the
+  // forward edge of the loop.
+ public:
+  using Next::Asm;
+
+  template <class... Args>
+  explicit LoadEliminationReducer(const std::tuple<Args...>& args)
+      : Next(args),
+        enabled_(v8_flags.turboshaft_load_elimination),
+        table_(Asm().phase_zone()),
+        block_to_snapshot_mapping_(Asm().input_graph().block_count(),
+                                   base::nullopt, Asm().phase_zone()),
+        predecessors_(Asm().phase_zone()),
+        address_to_key_(Asm().phase_zone()),
+        field_keys_(Asm().phase_zone()),
+        element_keys_(Asm().phase_zone()),
+        all_keys_(Asm().phase_zone()),
+        loop_effects_(Asm().input_graph().block_count(), nullptr,
+                      Asm().phase_zone()) {}
+
+  void Analyze() {
+    if (enabled_) {
+      LoopFinder loop_finder(Asm().phase_zone(), &Asm().input_graph());
+      for (const auto& [header, info] : loop_finder.LoopHeaders()) {
+        AnalyzeLoop(header, loop_finder.GetLoopBody(header));
+      }
+    }
+    Next::Analyze();
+  }
+
+  void Bind(Block* new_block, const Block* origin = nullptr) {
+    Next::Bind(new_block, origin);
+    if (!enabled_) return;
+
+    SealAndSave();
+
+    predecessors_.clear();
+    for (const Block* pred = new_block->LastPredecessor(); pred != nullptr;
+         pred = pred->NeighboringPredecessor()) {
+      DCHECK_LT(pred->index().id(), block_to_snapshot_mapping_.size());
+      base::Optional<Snapshot> pred_snapshot =
+          block_to_snapshot_mapping_[pred->index().id()];
+      DCHECK(pred_snapshot.has_value());
+      predecessors_.push_back(pred_snapshot.value());
+    }
+    std::reverse(predecessors_.begin(), predecessors_.end());
+
+    auto merge_values = [](Key, base::Vector<OpIndex> predecessors) -> OpIndex {
+      for (OpIndex idx : predecessors) {
+        if (idx != predecessors[0]) return OpIndex::Invalid();
+      }
+      return predecessors[0];
+    };
+    table_.StartNewSnapshot(base::VectorOf(predecessors_), merge_values);
+    current_block_ = new_block;
+
+    if (new_block->IsLoop()) {
+      // Only the forward edge has been emitted so far. Remove everything that
+      // the loop body could overwrite.
+      const LoopEffects* effects = nullptr;
+      if (origin != nullptr && origin->IsLoop()) {
+        effects = loop_effects_[origin->index().id()];
+      }
+      if (effects == nullptr || effects->clobbers_all) {
+        InvalidateAll();
+      } else {
+        for (const StoreEffect& store : effects->stores) {
+          InvalidateAfterStore(store.is_element, store.offset, store.size);
+        }
+      }
+    }
+  }
+
+  OpIndex ReduceLoad(OpIndex base, OpIndex index, LoadOp::Kind kind,
+                     MemoryRepresentation loaded_rep,
+                     RegisterRepresentation result_rep, int32_t offset,
+                     uint8_t element_size_log2) {
+    if (!enabled_ || !IsTrackedAccess(kind)) {
+      return Next::ReduceLoad(base, index, kind, loaded_rep, result_rep,
+                              offset, element_size_log2);
+    }
+    Key key = GetOrCreateKey(MemoryAddress{
+        base, index, offset, element_size_log2, loaded_rep, result_rep});
+    OpIndex known_value = table_.Get(key);
+    if (known_value.valid() && !ShouldSkipOptimizationStep()) {
+      return known_value;
+    }
+    OpIndex result = Next::ReduceLoad(base, index, kind, loaded_rep,
+                                      result_rep, offset, element_size_log2);
+    table_.Set(key, result);
+    return result;
+  }
+
+  OpIndex ReduceStore(OpIndex base, OpIndex index, OpIndex value,
+                      StoreOp::Kind kind, MemoryRepresentation stored_rep,
+                      WriteBarrierKind write_barrier, int32_t offset,
+                      uint8_t element_size_log2) {
+    if (enabled_) {
+      if (kind.tagged_base) {
+        InvalidateAfterStore(index.valid(), offset, stored_rep.SizeInBytes());
+      } else if (!IsExternalConstant(Asm().output_graph(), base)) {
+        InvalidateAll();
+      }
+    }
+    OpIndex result =
+        Next::ReduceStore(base, index, value, kind, stored_rep, write_barrier,
+                          offset, element_size_log2);
+    if (enabled_ && IsTrackedAccess(kind) && CanForward(value, stored_rep)) {
+      RegisterRepresentation value_rep = stored_rep.ToRegisterRepresentation();
+      Key key = GetOrCreateKey(MemoryAddress{
+          base, index, offset, element_size_log2, stored_rep, value_rep});
+      table_.Set(key, value);
+    }
+    return result;
+  }
+
+  OpIndex ReduceCall(OpIndex callee, OpIndex frame_state,
+                     base::Vector<const OpIndex> arguments,
+                     const TSCallDescriptor* descriptor) {
+    if (enabled_) InvalidateAll();
+    return Next::ReduceCall(callee, frame_state, arguments, descriptor);
+  }
+
+  OpIndex ReduceCallAndCatchException(OpIndex callee, OpIndex frame_state,
+                                      base::Vector<const OpIndex> arguments,
+                                      Block* if_success, Block* if_exception,
+                                      const TSCallDescriptor* descriptor) {
+    if (enabled_) InvalidateAll();
+    return Next::ReduceCallAndCatchException(callee, frame_state, arguments,
+                                             if_success, if_exception,
+                                             descriptor);
+  }
+
+ private:
+  using Table = SnapshotTable<OpIndex, MemoryAddress>;
+  using Key = Table::Key;
+  using Snapshot = Table::Snapshot;
+
+  // Accesses are at most 8 bytes wide.
+  static constexpr int kMaxAccessSize = 8;
+
+  struct StoreEffect {
+    bool is_element;
+    int32_t offset;
+    uint8_t size;
+
+    bool operator==(const StoreEffect& other) const {
+      return is_element == other.is_element && offset == other.offset &&
+             size == other.size;
+    }
+  };
+
+  // The stores contained in a loop of the input graph (including its inner
+  // loops).
+  struct LoopEffects {
+    explicit LoopEffects(Zone* zone) : stores(zone) {}
+    bool clobbers_all = false;
+    ZoneVector<StoreEffect> stores;
+  };
+
+  static bool IsTrackedAccess(LoadOp::Kind kind) {
+    return kind.tagged_base && !kind.maybe_unaligned && !kind.with_trap_handler;
+  }
+
+  static bool IsExternalConstant(const Graph& graph, OpIndex base) {
+    const ConstantOp* constant = graph.Get(base).TryCast<ConstantOp>();
+    return constant != nullptr && constant->kind == ConstantOp::Kind::kExternal;
+  }
+
+  // Stored values can only be forwarded to loads if the load would return them
+  // unchanged, which excludes narrow integers (which are sign- or
+  // zero-extended by loads).
+  bool CanForward(OpIndex value, MemoryRepresentation stored_rep) {
+    switch (stored_rep.value()) {
+      case MemoryRepresentation::Enum::kInt8:
+      case MemoryRepresentation::Enum::kUint8:
+      case MemoryRepresentation::Enum::kInt16:
+      case MemoryRepresentation::Enum::kUint16:
+      case MemoryRepresentation::Enum::kSandboxedPointer:
+        return false;
+      default:
+        break;
+    }
+    base::Vector<const RegisterRepresentation> value_reps =
+        Asm().output_graph().Get(value).outputs_rep();
+    return value_reps.size() == 1 &&
+           value_reps[0] == stored_rep.ToRegisterRepresentation();
+  }
+
+  Key GetOrCreateKey(const MemoryAddress& address) {
+    auto it = address_to_key_.find(address);
+    if (it != address_to_key_.end()) return it->second;
+    Key key = table_.NewKey(address, OpIndex::Invalid());
+    address_to_key_.insert({address, key});
+    if (address.index.valid()) {
+      element_keys_.push_back(key);
+    } else {
+      field_keys_.try_emplace(address.offset, Asm().phase_zone())
+          .first->second.push_back(key);
+    }
+    all_keys_.push_back(key);
+    return key;
+  }
+
+  void Invalidate(Key key) { table_.Set(key, OpIndex::Invalid()); }
+
+  void InvalidateAll() {
+    for (Key key : all_keys_) Invalidate(key);
+  }
+
+  // Invalidates the fields that end after {offset} and that start before
+  // {end}.
+  void InvalidateFields(int32_t offset, int32_t end) {
+    for (auto it = field_keys_.lower_bound(offset - kMaxAccessSize + 1);
+         it != field_keys_.end() && it->first < end; ++it) {
+      for (Key key : it->second) {
+        const MemoryAddress& address = key.data();
+        if (address.offset + address.rep.SizeInBytes() > offset) {
+          Invalidate(key);
+        }
+      }
+    }
+  }
+
+  void InvalidateAfterStore(bool is_element, int32_t offset, uint8_t size) {
+    if (is_element) {
+      InvalidateAll();
+      return;
+    }
+    for (Key key : element_keys_) Invalidate(key);
+    InvalidateFields(offset, offset + size);
+  }
+
+  // Records in {loop_effects_} which stores are executed by the loop starting
+  // at {header}, whose blocks are {body}.
+  void AnalyzeLoop(const Block* header,
+                   const ZoneVector<const Block*>& body) {
+    const Graph& graph = Asm().input_graph();
+    LoopEffects* effects = Asm().phase_zone()->template New<LoopEffects>(
+        Asm().phase_zone());
+    for (const Block* block : body) {
+      CollectStoreEffects(graph, *block, effects);
+      if (effects->clobbers_all) break;
+    }
+    loop_effects_[header->index().id()] = effects;
+  }
+
+  static void CollectStoreEffects(const Graph& graph, const Block& block,
+                                  LoopEffects* effects) {
+    for (const Operation& op : graph.operations(block)) {
+      if (effects->clobbers_all) return;
+      if (const StoreOp* store = op.TryCast<StoreOp>()) {
+        if (store->kind.tagged_base) {
+          StoreEffect effect{store->index().valid(), store->offset,
+                             store->stored_rep.SizeInBytes()};
+          if (std::find(effects->stores.begin(), effects->stores.end(),
+                        effect) == effects->stores.end()) {
+            effects->stores.push_back(effect);
+          }
+        } else if (!IsExternalConstant(graph, store->base())) {
+          effects->clobbers_all = true;
+        }
+      } else if (op.Is<CallOp>() || op.Is<CallAndCatchExceptionOp>()) {
+        effects->clobbers_all = true;
+      }
+    }
+  }
+
+  // SealAndSave seals the current snapshot, and stores it in
+  // {block_to_snapshot_mapping_}, so that it can be used for later merging.
+  void SealAndSave() {
+    if (table_.IsSealed()) {
+      DCHECK_EQ(current_block_, nullptr);
+      return;
+    }
+
+    DCHECK_NOT_NULL(current_block_);
+    Snapshot snapshot = table_.Seal();
+
+    DCHECK(current_block_->index().valid());
+    size_t id = current_block_->index().id();
+    if (id >= block_to_snapshot_mapping_.size()) {
+      static constexpr double kGrowthFactor = 1.5;
+      size_t new_size = std::max<size_t>(
+          id + 1, kGrowthFactor * block_to_snapshot_mapping_.size());
+      block_to_snapshot_mapping_.resize(new_size);
+    }
+
+    block_to_snapshot_mapping_[id] = snapshot;
+    current_block_ = nullptr;
+  }
+
+  const bool enabled_;
+  Table table_;
+  const Block* current_block_ = nullptr;
+  ZoneVector<base::Optional<Snapshot>> block_to_snapshot_mapping_;
+
+  // {predecessors_} is used during merging, but we use an instance variable for
+  // it, in order to save memory and not reallocate it for each merge.
+  ZoneVector<Snapshot> predecessors_;
+
+  ZoneUnorderedMap<MemoryAddress, Key> address_to_key_;
+  // Keys of field accesses, indexed by offset.
+  ZoneMap<int32_t, ZoneVector<Key>> field_keys_;
+  ZoneVector<Key> element_keys_;
+  ZoneVector<Key> all_keys_;
+
+  // Indexed by input-graph block id; only set for loop headers.
+  ZoneVector<LoopEffects*> loop_effects_;
+};
+
+}  // namespace v8::internal::compiler::turboshaft
+
+#endif  // V8_COMPILER_TURBOSHAFT_LOAD_ELIMINATION_REDUCER_H_
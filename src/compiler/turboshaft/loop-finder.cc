@@ -0,0 +1,83 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler/turboshaft/loop-finder.h"
+
+#include <algorithm>
+
+#include "src/compiler/turboshaft/operations.h"
+#include "src/compiler/turboshaft/optimization-phase.h"
+
+namespace v8::internal::compiler::turboshaft {
+
+void LoopFinder::Run() {
+  for (const Block& block : input_graph_->blocks()) {
+    if (block.IsLoop()) {
+      loop_infos_.insert({&block, VisitLoop(&block)});
+    }
+  }
+}
+
+template <class F>
+void LoopFinder::ForEachBlockOfLoop(const Block* header, F visit) {
+  // Every walk uses a fresh mark: the same loop is walked once by Run(), and
+  // then again by every call to GetLoopBody().
+  const uint32_t mark = ++current_mark_;
+  visited_[header->index().id()] = mark;
+
+  ZoneVector<const Block*> worklist(phase_zone_);
+  worklist.push_back(header->LastPredecessor());
+  while (!worklist.empty()) {
+    const Block* block = worklist.back();
+    worklist.pop_back();
+    if (visited_[block->index().id()] == mark) continue;
+    visited_[block->index().id()] = mark;
+    visit(block);
+    for (const Block* pred = block->LastPredecessor(); pred != nullptr;
+         pred = pred->NeighboringPredecessor()) {
+      worklist.push_back(pred);
+    }
+  }
+}
+
+LoopFinder::LoopInfo LoopFinder::VisitLoop(const Block* header) {
+  DCHECK(header->IsLoop());
+  // The last predecessor of a loop header is its backedge.
+  const Block* backedge = header->LastPredecessor();
+  DCHECK_GE(backedge->index().id(), header->index().id());
+
+  LoopInfo info;
+  info.header = header;
+  auto visit = [&](const Block* block) {
+    info.block_count++;
+    if (block != header && block->IsLoop()) info.has_inner_loops = true;
+    if (block->index().id() < header->index().id() ||
+        block->index().id() > backedge->index().id()) {
+      info.is_well_ordered = false;
+    }
+    for (const Operation& op : input_graph_->operations(*block)) {
+      if (ShouldSkipOperation(op)) continue;
+      info.op_count++;
+      if (op.Is<CallAndCatchExceptionOp>()) {
+        info.has_call_and_catch_exception = true;
+      }
+    }
+  };
+  visit(header);
+  ForEachBlockOfLoop(header, visit);
+  return info;
+}
+
+ZoneVector<const Block*> LoopFinder::GetLoopBody(const Block* header) {
+  ZoneVector<const Block*> body(phase_zone_);
+  body.push_back(header);
+  ForEachBlockOfLoop(header,
+                     [&body](const Block* block) { body.push_back(block); });
+  std::sort(body.begin(), body.end(), [](const Block* a, const Block* b) {
+    return a->index().id() < b->index().id();
+  });
+  return body;
+}
+
+}  // namespace v8::internal::compiler::turboshaft
@@ -0,0 +1,80 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_COMPILER_TURBOSHAFT_LOOP_FINDER_H_
+#define V8_COMPILER_TURBOSHAFT_LOOP_FINDER_H_
+
+#include "src/compiler/turboshaft/graph.h"
+#include "src/compiler/turboshaft/index.h"
+#include "src/zone/zone-containers.h"
+#include "src/zone/zone.h"
+
+namespace v8::internal::compiler::turboshaft {
+
+// LoopFinder discovers the loops of a Turboshaft graph. The body of a loop is
+// made of the blocks from which the backedge can be reached without going
+// through the loop header; blocks that leave the loop for good (like
+// deoptimization or return blocks) are thus not part of the body.
+class LoopFinder {
+ public:
+  struct LoopInfo {
+    const Block* header = nullptr;
+    // Number of blocks and (used) operations of the loop, including the
+    // header and the inner loops.
+    uint32_t block_count = 0;
+    uint32_t op_count = 0;
+    bool has_inner_loops = false;
+    // CallAndCatchException cannot be cloned, since the Variables mapping its
+    // projections cannot be merged.
+    bool has_call_and_catch_exception = false;
+    // The loop header is the block with the smallest index of the body and the
+    // backedge the one with the largest index. This is the case for graphs
+    // coming from a TurboFan schedule, and is required to clone the loop by
+    // visiting its blocks in order.
+    bool is_well_ordered = true;
+  };
+
+  LoopFinder(Zone* phase_zone, const Graph* input_graph)
+      : phase_zone_(phase_zone),
+        input_graph_(input_graph),
+        loop_infos_(phase_zone),
+        visited_(input_graph->block_count(), 0, phase_zone) {
+    Run();
+  }
+
+  const ZoneUnorderedMap<const Block*, LoopInfo>& LoopHeaders() const {
+    return loop_infos_;
+  }
+  const LoopInfo& GetLoopInfo(const Block* header) const {
+    DCHECK(header->IsLoop());
+    auto it = loop_infos_.find(header);
+    DCHECK_NE(it, loop_infos_.end());
+    return it->second;
+  }
+
+  // Returns the blocks of the loop starting at {header}, sorted by index (the
+  // header thus comes first).
+  ZoneVector<const Block*> GetLoopBody(const Block* header);
+
+ private:
+  void Run();
+  LoopInfo VisitLoop(const Block* header);
+
+  // Walks the predecessors from the backedge of the loop starting at {header}
+  // and calls {visit} for every block of the loop (except the header).
+  template <class F>
+  void ForEachBlockOfLoop(const Block* header, F visit);
+
+  Zone* phase_zone_;
+  const Graph* input_graph_;
+  ZoneUnorderedMap<const Block*, LoopInfo> loop_infos_;
+  // Marks the blocks that have been visited by the walk number `mark`, so that
+  // the vector can be reused for all walks without being cleared.
+  ZoneVector<uint32_t> visited_;
+  uint32_t current_mark_ = 0;
+};
+
+}  // namespace v8::internal::compiler::turboshaft
+
+#endif  // V8_COMPILER_TURBOSHAFT_LOOP_FINDER_H_
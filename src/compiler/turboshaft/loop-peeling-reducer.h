@@ -0,0 +1,113 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_COMPILER_TURBOSHAFT_LOOP_PEELING_REDUCER_H_
+#define V8_COMPILER_TURBOSHAFT_LOOP_PEELING_REDUCER_H_
+
+#include "src/base/logging.h"
+#include "src/base/vector.h"
+#include "src/compiler/turboshaft/assembler.h"
+#include "src/compiler/turboshaft/graph.h"
+#include "src/compiler/turboshaft/index.h"
+#include "src/compiler/turboshaft/loop-finder.h"
+#include "src/compiler/turboshaft/operations.h"
+
+namespace v8::internal::compiler::turboshaft {
+
+// LoopPeelingReducer emits the first iteration of innermost loops before the
+// loop itself. Loop-invariant checks and loads of the loop body are thus
+// dominated by their peeled copy, which allows the subsequent reducers
+// (ValueNumberingReducer and BranchEliminationReducer in particular) to remove
+// them from the loop.
+//
+// This is done when visiting the forward edge of the loop (the Goto to the loop
+// header): the loop is copied a first time with its header turned into a
+// regular block, and the backedge of this copy (which is left open by
+// ReduceGoto) then jumps to a second copy of the loop, whose Phis thus start
+// with the values of the backedge of the peeled iteration.
+template <class Next>
+class LoopPeelingReducer : public Next {
+ public:
+  using Next::Asm;
+
+  // Loops whose body has more operations than this are not peeled. This is
+  // the same limit as TurboFan's LoopPeeler::kMaxPeeledNodes.
+  static constexpr uint32_t kMaxPeeledOperations = 1000;
+
+  template <class... Args>
+  explicit LoopPeelingReducer(const std::tuple<Args...>& args)
+      : Next(args), loop_finder_(Asm().phase_zone(), &Asm().input_graph()) {}
+
+  OpIndex ReduceGoto(Block* destination) {
+    LABEL_BLOCK(no_change) { return Next::ReduceGoto(destination); }
+
+    const Block* origin = destination->Origin();
+    switch (peeling_) {
+      case PeelingStatus::kNotPeeling:
+        // {destination} is not bound yet when coming from the forward edge.
+        if (destination->IsLoop() && !destination->IsBound() &&
+            origin != nullptr && CanPeelLoop(origin) &&
+            !ShouldSkipOptimizationStep()) {
+          PeelFirstIteration(origin);
+          return OpIndex::Invalid();
+        }
+        break;
+      case PeelingStatus::kEmittingPeeledLoop:
+        if (origin == current_loop_header_ && destination->IsBound()) {
+          // This is the backedge of the peeled iteration. It is left open:
+          // PeelFirstIteration will make it jump to the unpeeled loop.
+          return OpIndex::Invalid();
+        }
+        break;
+      case PeelingStatus::kEmittingUnpeeledBody:
+        break;
+    }
+    goto no_change;
+  }
+
+ private:
+  enum class PeelingStatus {
+    kNotPeeling,
+    kEmittingPeeledLoop,
+    kEmittingUnpeeledBody,
+  };
+
+  bool CanPeelLoop(const Block* header) {
+    const LoopFinder::LoopInfo& info = loop_finder_.GetLoopInfo(header);
+    return !info.has_inner_loops && !info.has_call_and_catch_exception &&
+           info.is_well_ordered && info.op_count <= kMaxPeeledOperations;
+  }
+
+  void PeelFirstIteration(const Block* header) {
+    DCHECK_EQ(peeling_, PeelingStatus::kNotPeeling);
+    ZoneVector<const Block*> loop_body = loop_finder_.GetLoopBody(header);
+    current_loop_header_ = header;
+
+    // Emitting the peeled iteration.
+    peeling_ = PeelingStatus::kEmittingPeeledLoop;
+    Asm().CloneSubGraph(base::VectorOf(loop_body), /* keep_loop_kinds */ false,
+                        /* from_backedge */ false);
+
+    if (Asm().current_block() != nullptr) {
+      // Emitting the unpeeled loop, starting from the backedge of the peeled
+      // iteration.
+      peeling_ = PeelingStatus::kEmittingUnpeeledBody;
+      Asm().CloneSubGraph(base::VectorOf(loop_body),
+                          /* keep_loop_kinds */ true, /* from_backedge */ true);
+    }
+    // If the peeled iteration always exits the loop, then the loop is dead and
+    // doesn't need to be emitted.
+
+    peeling_ = PeelingStatus::kNotPeeling;
+    current_loop_header_ = nullptr;
+  }
+
+  PeelingStatus peeling_ = PeelingStatus::kNotPeeling;
+  const Block* current_loop_header_ = nullptr;
+  LoopFinder loop_finder_;
+};
+
+}  // namespace v8::internal::compiler::turboshaft
+
+#endif  // V8_COMPILER_TURBOSHAFT_LOOP_PEELING_REDUCER_H_
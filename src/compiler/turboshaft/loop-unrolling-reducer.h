@@ -0,0 +1,221 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_COMPILER_TURBOSHAFT_LOOP_UNROLLING_REDUCER_H_
+#define V8_COMPILER_TURBOSHAFT_LOOP_UNROLLING_REDUCER_H_
+
+#include <algorithm>
+
+#include "src/base/logging.h"
+#include "src/base/vector.h"
+#include "src/compiler/turboshaft/assembler.h"
+#include "src/compiler/turboshaft/graph.h"
+#include "src/compiler/turboshaft/index.h"
+#include "src/compiler/turboshaft/loop-finder.h"
+#include "src/compiler/turboshaft/operations.h"
+
+namespace v8::internal::compiler::turboshaft {
+
+// LoopUnrollingReducer partially unrolls small innermost counted loops: the
+// body of the loop is emitted {unroll_count} times in a row, each copy jumping
+// to the next one, and the last copy jumping back to the first one. Each copy
+// keeps its exit checks, which means that this is correct regardless of the
+// actual number of iterations of the loop; the benefit comes from the
+// reduction of the number of backedges (and of their stack checks), and from
+// the opportunities that the copies give to subsequent reducers.
+//
+// Loops are considered "counted" when their exit condition compares an
+// induction variable, ie, a Phi of the loop header that is incremented or
+// decremented by a constant on every iteration.
+template <class Next>
+class LoopUnrollingReducer : public Next {
+ public:
+  using Next::Asm;
+
+  // Same heuristic as TurboFan's loop unrolling (see
+  // compiler/loop-unrolling.h): small loops are unrolled up to
+  // {kMaximumUnrollingCount} times, so that the total size of the unrolled
+  // loop stays below {kMaximumUnrolledSize}.
+  static constexpr uint32_t kMaximumUnrolledSize = 50;
+  static constexpr uint32_t kMaximumUnrollingCount = 5;
+
+  template <class... Args>
+  explicit LoopUnrollingReducer(const std::tuple<Args...>& args)
+      : Next(args),
+        loop_finder_(Asm().phase_zone(), &Asm().input_graph()),
+        loop_body_(Asm().phase_zone()) {}
+
+  OpIndex ReduceGoto(Block* destination) {
+    LABEL_BLOCK(no_change) { return Next::ReduceGoto(destination); }
+
+    const Block* origin = destination->Origin();
+    if (current_loop_header_ == nullptr) {
+      // {destination} is not bound yet when coming from the forward edge.
+      if (destination->IsLoop() && !destination->IsBound() &&
+          origin != nullptr) {
+        uint32_t unroll_count = GetUnrollCount(origin);
+        if (unroll_count > 1 && !ShouldSkipOptimizationStep()) {
+          UnrollLoop(origin, unroll_count);
+          return OpIndex::Invalid();
+        }
+      }
+      goto no_change;
+    }
+
+    if (origin != current_loop_header_) goto no_change;
+    if (!destination->IsBound()) {
+      // Forward edge of one of the copies. Only the first copy is a loop.
+      if (destination->IsLoop()) {
+        DCHECK_NULL(output_loop_header_);
+        output_loop_header_ = destination;
+      }
+      goto no_change;
+    }
+
+    // Backedge of one of the copies.
+    if (remaining_copies_ > 0) {
+      remaining_copies_--;
+      Asm().CloneSubGraph(base::VectorOf(loop_body_),
+                          /* keep_loop_kinds */ false,
+                          /* from_backedge */ true);
+    } else {
+      Next::ReduceGoto(output_loop_header_);
+      Asm().FixLoopPhis(output_loop_header_);
+    }
+    return OpIndex::Invalid();
+  }
+
+ private:
+  uint32_t GetUnrollCount(const Block* header) {
+    const LoopFinder::LoopInfo& info = loop_finder_.GetLoopInfo(header);
+    if (info.has_inner_loops || info.has_call_and_catch_exception ||
+        !info.is_well_ordered || info.op_count == 0) {
+      return 0;
+    }
+    if (!IsCountedLoop(header)) return 0;
+    return std::min(kMaximumUnrolledSize / info.op_count,
+                    kMaximumUnrollingCount);
+  }
+
+  void UnrollLoop(const Block* header, uint32_t unroll_count) {
+    DCHECK_NULL(current_loop_header_);
+    current_loop_header_ = header;
+    loop_body_ = loop_finder_.GetLoopBody(header);
+    remaining_copies_ = unroll_count - 1;
+
+    Asm().CloneSubGraph(base::VectorOf(loop_body_), /* keep_loop_kinds */ true,
+                        /* from_backedge */ false);
+
+    // If the backedge of the last copy turned out to be unreachable, then the
+    // loop isn't a loop anymore.
+    DCHECK_NOT_NULL(output_loop_header_);
+    if (output_loop_header_->IsLoop() &&
+        output_loop_header_->PredecessorCount() == 1) {
+      Asm().output_graph().TurnLoopIntoMerge(output_loop_header_);
+    }
+
+    current_loop_header_ = nullptr;
+    output_loop_header_ = nullptr;
+  }
+
+  bool IsCountedLoop(const Block* header) {
+    const Graph& graph = Asm().input_graph();
+    // The exit condition is either at the beginning of the loop (in the loop
+    // header), or at the end (in the predecessor of the backedge).
+    if (IsInductionVariableCheck(header->LastOperation(graph), header)) {
+      return true;
+    }
+    const Block* backedge = header->LastPredecessor();
+    const Block* latch = backedge->LastPredecessor();
+    return latch != nullptr && latch->NeighboringPredecessor() == nullptr &&
+           latch != header &&
+           IsInductionVariableCheck(latch->LastOperation(graph), header);
+  }
+
+  bool IsInductionVariableCheck(const Operation& op, const Block* header) {
+    const BranchOp* branch = op.TryCast<BranchOp>();
+    if (branch == nullptr) return false;
+    const Operation& cond = Asm().input_graph().Get(branch->condition());
+    if (const ComparisonOp* cmp = cond.TryCast<ComparisonOp>()) {
+      return IsInductionVariable(cmp->left(), header) ||
+             IsInductionVariable(cmp->right(), header);
+    }
+    if (const EqualOp* equal = cond.TryCast<EqualOp>()) {
+      return IsInductionVariable(equal->left(), header) ||
+             IsInductionVariable(equal->right(), header);
+    }
+    return false;
+  }
+
+  // Returns true if {index} is a Phi of {header} that is incremented or
+  // decremented by a constant on the backedge, or is this increment.
+  bool IsInductionVariable(OpIndex index, const Block* header) {
+    const Graph& graph = Asm().input_graph();
+    if (const PhiOp* phi = graph.Get(index).TryCast<PhiOp>()) {
+      if (!header->Contains(index)) return false;
+      return IsIncrementOf(phi->input(PhiOp::kLoopPhiBackEdgeIndex), index);
+    }
+    OpIndex binop = index;
+    if (const ProjectionOp* proj = graph.Get(index).TryCast<ProjectionOp>()) {
+      if (proj->index != 0) return false;
+      binop = proj->input();
+    }
+    OpIndex left;
+    if (const WordBinopOp* op = graph.Get(binop).TryCast<WordBinopOp>()) {
+      left = op->left();
+    } else if (const OverflowCheckedBinopOp* op =
+                   graph.Get(binop).TryCast<OverflowCheckedBinopOp>()) {
+      left = op->left();
+    } else {
+      return false;
+    }
+    const PhiOp* phi = graph.Get(left).TryCast<PhiOp>();
+    return phi != nullptr && header->Contains(left) &&
+           phi->input(PhiOp::kLoopPhiBackEdgeIndex) == index &&
+           IsIncrementOf(index, left);
+  }
+
+  // Returns true if {index} is `{phi} + c` or `{phi} - c` for some constant c,
+  // possibly with an overflow check.
+  bool IsIncrementOf(OpIndex index, OpIndex phi) {
+    const Graph& graph = Asm().input_graph();
+    if (const ProjectionOp* proj = graph.Get(index).TryCast<ProjectionOp>()) {
+      if (proj->index != 0) return false;
+      index = proj->input();
+    }
+    OpIndex left, right;
+    if (const WordBinopOp* op = graph.Get(index).TryCast<WordBinopOp>()) {
+      if (op->kind != WordBinopOp::Kind::kAdd &&
+          op->kind != WordBinopOp::Kind::kSub) {
+        return false;
+      }
+      left = op->left();
+      right = op->right();
+    } else if (const OverflowCheckedBinopOp* op =
+                   graph.Get(index).TryCast<OverflowCheckedBinopOp>()) {
+      if (op->kind != OverflowCheckedBinopOp::Kind::kSignedAdd &&
+          op->kind != OverflowCheckedBinopOp::Kind::kSignedSub) {
+        return false;
+      }
+      left = op->left();
+      right = op->right();
+    } else {
+      return false;
+    }
+    return left == phi && graph.Get(right).Is<ConstantOp>();
+  }
+
+  LoopFinder loop_finder_;
+  // The loop being unrolled, and the blocks of its body.
+  const Block* current_loop_header_ = nullptr;
+  ZoneVector<const Block*> loop_body_;
+  // The header of the first copy of the loop, which is the only one that is
+  // still a loop header in the output graph.
+  Block* output_loop_header_ = nullptr;
+  uint32_t remaining_copies_ = 0;
+};
+
+}  // namespace v8::internal::compiler::turboshaft
+
+#endif  // V8_COMPILER_TURBOSHAFT_LOOP_UNROLLING_REDUCER_H_
@@ -235,6 +235,72 @@ class GraphVisitor {
     visiting_cloned_block_ = false;
   }
 
+  // Emits a copy of the loop {sub_graph} (whose blocks are sorted by index, the
+  // loop header coming first, and the backedge last), and ends the current
+  // block with a Goto to the copy of the loop header. Values of the copied
+  // operations are mapped through Variables, so that they can be merged with
+  // the ones of other copies where control flow joins again.
+  // If {keep_loop_kinds} is false, the loop header is copied into a regular
+  // block, whose Phis only have their value on entry; its backedge is left to
+  // the reducer that requested the copy (see for instance LoopPeelingReducer).
+  // {from_backedge} indicates that the copy is entered from the backedge of a
+  // previous copy of the loop rather than from its forward edge, which
+  // determines the value of the Phis of the loop header on entry.
+  void CloneSubGraph(base::Vector<const Block* const> sub_graph,
+                     bool keep_loop_kinds, bool from_backedge) {
+    const Block* header = sub_graph[0];
+    DCHECK(header->IsLoop());
+    DCHECK(std::is_sorted(sub_graph.begin(), sub_graph.end(),
+                          [](const Block* a, const Block* b) {
+                            return a->index().id() < b->index().id();
+                          }));
+
+    // The value of the loop Phis on entry has to be computed now, since it is
+    // defined by the block that jumps to the copy.
+    base::SmallVector<std::pair<OpIndex, OpIndex>, 16> entry_values;
+    for (OpIndex index : input_graph().OperationIndices(*header)) {
+      const Operation& op = input_graph().Get(index);
+      if (ShouldSkipOperation(op)) continue;
+      if (const PhiOp* phi = op.TryCast<PhiOp>()) {
+        OpIndex input =
+            phi->input(from_backedge ? PhiOp::kLoopPhiBackEdgeIndex : 0);
+        entry_values.emplace_back(index, MapToNewGraph(input));
+      }
+    }
+
+    // Updating {block_mapping_}, so that jumps between the blocks of
+    // {sub_graph} go to their copy. The previous mapping is restored at the
+    // end.
+    base::SmallVector<Block*, 16> old_mappings;
+    for (const Block* block : sub_graph) {
+      old_mappings.push_back(block_mapping_[block->index().id()]);
+      Block* new_block = keep_loop_kinds && block->IsLoop()
+                             ? assembler().NewLoopHeader()
+                             : assembler().NewBlock();
+      new_block->SetOrigin(block);
+      block_mapping_[block->index().id()] = new_block;
+      blocks_needing_variables.insert(block->index());
+    }
+
+    const Block* saved_input_block = current_input_block_;
+    bool saved_needs_variables = current_block_needs_variables_;
+    base::Vector<const std::pair<OpIndex, OpIndex>> saved_entry_values =
+        loop_entry_values_;
+    loop_entry_values_ = base::VectorOf(entry_values);
+
+    assembler().Goto(MapToNewGraph(header->index()));
+    for (const Block* block : sub_graph) {
+      VisitBlock<false>(block);
+    }
+
+    loop_entry_values_ = saved_entry_values;
+    current_block_needs_variables_ = saved_needs_variables;
+    current_input_block_ = saved_input_block;
+    for (size_t i = 0; i < sub_graph.size(); i++) {
+      block_mapping_[sub_graph[i]->index().id()] = old_mappings[i];
+    }
+  }
+
   template <bool can_be_invalid = false>
   OpIndex MapToNewGraph(OpIndex old_index, int predecessor_index = -1) {
     DCHECK(old_index.valid());
@@ -266,6 +332,19 @@ class GraphVisitor {
     return result;
   }
 
+  void FixLoopPhis(Block* loop) {
+    DCHECK(loop->IsLoop());
+    for (Operation& op : assembler().output_graph().operations(*loop)) {
+      if (auto* pending_phi = op.TryCast<PendingLoopPhiOp>()) {
+        assembler().output_graph().template Replace<PhiOp>(
+            assembler().output_graph().Index(*pending_phi),
+            base::VectorOf({pending_phi->first(),
+                            MapToNewGraph(pending_phi->old_backedge_index)}),
+            pending_phi->rep);
+      }
+    }
+  }
+
  private:
   template <bool trace_reduction>
   void VisitAllBlocks() {
@@ -307,8 +386,9 @@ class GraphVisitor {
           *base::Reversed(input_graph().operations(*input_block)).begin();
       if (auto* final_goto = last_op.TryCast<GotoOp>()) {
         if (final_goto->destination->IsLoop()) {
+          // {new_loop} is not a loop if the loop header has been copied into a
+          // regular block (see CloneSubGraph).
           Block* new_loop = MapToNewGraph(final_goto->destination->index());
-          DCHECK(new_loop->IsLoop());
           if (new_loop->IsLoop() && new_loop->PredecessorCount() == 1) {
             output_graph_.TurnLoopIntoMerge(new_loop);
           }
@@ -339,14 +419,18 @@ class GraphVisitor {
     OpIndex new_index;
     if (input_block->IsLoop() && op.Is<PhiOp>()) {
       const PhiOp& phi = op.Cast<PhiOp>();
-      if (index == phi.input(PhiOp::kLoopPhiBackEdgeIndex)) {
+      OpIndex entry_value = MapLoopPhiEntryValue(index, phi);
+      if (!current_block->IsLoop()) {
+        // The loop header has been copied into a regular block (see
+        // CloneSubGraph), which is only entered once.
+        new_index = entry_value;
+      } else if (index == phi.input(PhiOp::kLoopPhiBackEdgeIndex)) {
         // Avoid emitting a Loop Phi which points to itself, instead
         // emit it's 0'th input.
-        new_index = MapToNewGraph(phi.input(0));
+        new_index = entry_value;
       } else {
-        new_index =
-            assembler().PendingLoopPhi(MapToNewGraph(phi.input(0)), phi.rep,
-                                       phi.input(PhiOp::kLoopPhiBackEdgeIndex));
+        new_index = assembler().PendingLoopPhi(
+            entry_value, phi.rep, phi.input(PhiOp::kLoopPhiBackEdgeIndex));
       }
       CreateOldToNewMapping(index, new_index);
       if constexpr (trace_reduction) {
@@ -418,8 +502,12 @@ class GraphVisitor {
   V8_INLINE OpIndex VisitGoto(const GotoOp& op) {
     Block* destination = MapToNewGraph(op.destination->index());
     assembler().ReduceGoto(destination);
-    if (destination->IsBound()) {
-      DCHECK(destination->IsLoop());
+    // If {destination} is a loop header that has been copied by CloneSubGraph,
+    // then the reducer that made the copy took care of the backedge: the copy
+    // might not be a loop, or its backedge might not come from here (in which
+    // case its Phis are already fixed, or the backedge is missing).
+    if (destination->IsBound() && destination->IsLoop() &&
+        destination->PredecessorCount() == 2) {
       FixLoopPhis(destination);
     }
     return OpIndex::Invalid();
@@ -750,17 +838,13 @@ class GraphVisitor {
     return result;
   }
 
-  void FixLoopPhis(Block* loop) {
-    DCHECK(loop->IsLoop());
-    for (Operation& op : assembler().output_graph().operations(*loop)) {
-      if (auto* pending_phi = op.TryCast<PendingLoopPhiOp>()) {
-        assembler().output_graph().template Replace<PhiOp>(
-            assembler().output_graph().Index(*pending_phi),
-            base::VectorOf({pending_phi->first(),
-                            MapToNewGraph(pending_phi->old_backedge_index)}),
-            pending_phi->rep);
-      }
+  // Returns the value that the loop Phi {phi} (at {index} in the input graph)
+  // has when entering its loop header.
+  OpIndex MapLoopPhiEntryValue(OpIndex index, const PhiOp& phi) {
+    for (auto [phi_index, entry_value] : loop_entry_values_) {
+      if (phi_index == index) return entry_value;
     }
+    return MapToNewGraph(phi.input(0));
   }
 
   // TODO(dmercadier,tebbi): unify the ways we refer to the Assembler.
@@ -786,6 +870,9 @@ class GraphVisitor {
   // used to replace those Phis.
   int added_block_phi_input_;
 
+  // Values of the Phis of the loop header copied by CloneSubGraph on entry.
+  base::Vector<const std::pair<OpIndex, OpIndex>> loop_entry_values_;
+
   // {current_block_needs_variables_} is set to true if the current block should
   // use Variables to map old to new OpIndex rather than just {op_mapping}. This
   // is typically the case when the block has been cloned.
@@ -339,7 +339,13 @@ void TieringManager::MaybeOptimizeFrame(JSFunction function,
 
 OptimizationDecision TieringManager::ShouldOptimize(
     JSFunction function, CodeKind calling_code_kind) {
-  if (TiersUpToMaglev(calling_code_kind) &&
+  // Functions that were optimized by Turbofan without deoptimizing in the run
+  // that produced their code cache skip Maglev, and are optimized as soon as
+  // they have been through an interrupt budget with feedback.
+  const bool has_tier_up_hint =
+      V8_UNLIKELY(v8_flags.code_cache_tiering_hints) &&
+      function.shared().turbofan_tier_up_hint();
+  if (TiersUpToMaglev(calling_code_kind) && !has_tier_up_hint &&
       function.shared().PassesFilter(v8_flags.maglev_filter) &&
       !function.shared(isolate_).maglev_compilation_failed()) {
     return OptimizationDecision::Maglev();
@@ -359,8 +365,10 @@ OptimizationDecision TieringManager::ShouldOptimize(
   }
   const int ticks = function.feedback_vector().profiler_ticks();
   const int ticks_for_optimization =
-      v8_flags.ticks_before_optimization +
-      (bytecode.length() / v8_flags.bytecode_size_allowance_per_tick);
+      has_tier_up_hint
+          ? 1
+          : v8_flags.ticks_before_optimization +
+                (bytecode.length() / v8_flags.bytecode_size_allowance_per_tick);
   if (ticks >= ticks_for_optimization) {
     return OptimizationDecision::TurbofanHotAndStable();
   } else if (ShouldOptimizeAsSmallFunction(bytecode.length(),
@@ -570,6 +570,11 @@ DEFINE_NEG_NEG_IMPLICATION(allocation_site_tracking,
 // Flags for experimental implementation features.
 DEFINE_BOOL(allocation_site_pretenuring, true,
             "pretenure with allocation sites")
+DEFINE_BOOL(allocation_site_pretenuring_decay, false,
+            "decay allocation site pretenuring feedback across GCs instead of "
+            "resetting it and allow sites to revisit their decision")
+DEFINE_IMPLICATION(allocation_site_pretenuring_decay,
+                   allocation_site_pretenuring)
 DEFINE_BOOL(page_promotion, true, "promote pages based on utilization")
 DEFINE_INT(page_promotion_threshold, 70,
            "min percentage of live bytes on a page to enable fast evacuation")
@@ -742,6 +747,9 @@ DEFINE_BOOL(
 // (enabled by --shared-string-table) are not supported using a single shared
 // forwarding table.
 DEFINE_NEG_IMPLICATION(shared_string_table, always_use_string_forwarding_table)
+DEFINE_BOOL(lock_free_string_table_insertion, true,
+            "add copied strings to the string table without taking its "
+            "write mutex")
 
 DEFINE_BOOL(transition_strings_during_gc_with_stack, false,
             "Transition strings during a full GC with stack")
@@ -972,6 +980,9 @@ DEFINE_BOOL(turbo_use_mid_tier_regalloc_for_huge_functions, true,
             "fall back to the mid-tier register allocator for huge functions")
 DEFINE_BOOL(turbo_force_mid_tier_regalloc, false,
             "always use the mid-tier register allocator (for testing)")
+DEFINE_BOOL(turbo_parallel_register_allocation, false,
+            "allocate the general, floating-point and SIMD registers "
+            "concurrently in the top-tier register allocator")
 
 DEFINE_BOOL(turbo_optimize_apply, true, "optimize Function.prototype.apply")
 DEFINE_BOOL(turbo_optimize_math_minmax, true,
@@ -991,6 +1002,13 @@ DEFINE_FLOAT(script_delay_fraction, 0.0,
 DEFINE_BOOL(turboshaft, false, "enable TurboFan's Turboshaft phases for JS")
 DEFINE_BOOL(turboshaft_trace_reduction, false,
             "trace individual Turboshaft reduction steps")
+DEFINE_BOOL(turboshaft_load_elimination, true,
+            "eliminate redundant loads in Turboshaft's late optimization "
+            "phase")
+DEFINE_BOOL(turboshaft_loop_peeling, false,
+            "peel the first iteration of innermost loops in Turboshaft")
+DEFINE_BOOL(turboshaft_loop_unrolling, false,
+            "unroll small innermost counted loops in Turboshaft")
 DEFINE_BOOL(turboshaft_wasm, false,
             "enable TurboFan's Turboshaft phases for wasm")
 #ifdef DEBUG
@@ -1327,6 +1345,9 @@ DEFINE_BOOL(trace_evacuation, false, "report evacuation statistics")
 DEFINE_BOOL(trace_mutator_utilization, false,
             "print mutator utilization, allocation speed, gc speed")
 DEFINE_BOOL(incremental_marking, true, "use incremental marking")
+DEFINE_BOOL(buffered_marking_barrier, false,
+            "record values of the main thread marking barrier in a buffer "
+            "and mark them in batches")
 DEFINE_BOOL(incremental_marking_wrappers, true,
             "use incremental marking for marking wrappers")
 DEFINE_BOOL(incremental_marking_task, true, "use tasks for incremental marking")
@@ -1338,6 +1359,11 @@ DEFINE_INT(incremental_marking_hard_trigger, 0,
            "threshold for starting incremental marking immediately in percent "
            "of available space: limit - size")
 DEFINE_BOOL(trace_unmapper, false, "Trace the unmapping")
+DEFINE_UINT(max_pooled_pages, 128,
+            "maximum number of released regular pages that are kept "
+            "uncommitted for reuse instead of being unmapped")
+DEFINE_BOOL(pool_old_generation_pages, true,
+            "return released old generation pages to the page pool")
 DEFINE_INT(minor_mc_task_trigger, 80,
            "minormc task trigger in percent of the current heap limit")
 DEFINE_BOOL(parallel_scavenge, true, "parallel scavenge")
@@ -1347,6 +1373,8 @@ DEFINE_INT(scavenge_task_trigger, 80,
 DEFINE_BOOL(scavenge_separate_stack_scanning, false,
             "use a separate phase for stack scanning in scavenge")
 DEFINE_BOOL(trace_parallel_scavenge, false, "trace parallel scavenge")
+DEFINE_BOOL(scavenge_work_sharing, true,
+            "publish thread-local scavenger work while other tasks are idle")
 DEFINE_BOOL(cppgc_young_generation, false,
             "run young generation garbage collections in Oilpan")
 // CppGC young generation (enables unified young heap) is based on Minor MC.
@@ -1369,6 +1397,9 @@ DEFINE_BOOL(concurrent_array_buffer_sweeping, true,
             "concurrently sweep array buffers")
 DEFINE_BOOL(stress_concurrent_allocation, false,
             "start background threads that allocate memory")
+DEFINE_BOOL(concurrent_allocator_adaptive_lab_size, true,
+            "grow background thread LABs on repeated refills to reduce "
+            "contention on the space free list")
 DEFINE_BOOL(parallel_marking, true, "use parallel marking in atomic pause")
 DEFINE_INT(ephemeron_fixpoint_iterations, 10,
            "number of fixpoint iterations it takes to switch to linear "
@@ -1388,6 +1419,15 @@ DEFINE_BOOL(track_gc_object_stats, false,
             "track object counts and memory usage")
 DEFINE_BOOL(trace_gc_object_stats, false,
             "trace object counts and memory usage")
+DEFINE_BOOL(track_object_lifetimes, false,
+            "sample young generation allocations and record the number of "
+            "young generation GCs they survive before dying or being promoted")
+DEFINE_BOOL(trace_object_lifetimes, false,
+            "print object lifetime histograms when the isolate is torn down")
+DEFINE_IMPLICATION(trace_object_lifetimes, track_object_lifetimes)
+DEFINE_INT(object_lifetime_sample_interval, 64 * KB,
+           "number of young generation bytes allocated between samples for "
+           "--track-object-lifetimes")
 DEFINE_BOOL(trace_zone_stats, false, "trace zone memory usage")
 DEFINE_GENERIC_IMPLICATION(
     trace_zone_stats,
@@ -1436,6 +1476,9 @@ DEFINE_BOOL(move_object_start, true, "enable moving of object starts")
 DEFINE_BOOL(memory_reducer, true, "use memory reducer")
 DEFINE_BOOL(memory_reducer_for_small_heaps, true,
             "use memory reducer for small heaps")
+DEFINE_BOOL(discard_free_memory_on_memory_pressure, true,
+            "return free memory of swept pages to the OS on moderate memory "
+            "pressure")
 DEFINE_INT(heap_growing_percent, 0,
            "specifies heap growing factor as (1 + heap_growing_percent/100)")
 DEFINE_INT(v8_os_page_size, 0, "override OS page size (in KBytes)")
@@ -1451,6 +1494,15 @@ DEFINE_BOOL(compact_with_stack, true,
 DEFINE_BOOL(
     compact_code_space_with_stack, true,
     "Perform code space compaction when finalizing a full GC with stack")
+DEFINE_FLOAT(gc_pause_target_ms, 0.0,
+             "target upper bound for individual GC pauses in milliseconds; "
+             "adapts incremental marking steps, the young generation size and "
+             "evacuation to it (0 means default heuristics)")
+DEFINE_FLOAT(compaction_pause_budget_ms, 0.0,
+             "limit the bytes selected for evacuation on a full GC such that "
+             "evacuation is expected to take at most this many milliseconds, "
+             "leaving remaining fragmented pages to later cycles (0 means no "
+             "limit)")
 DEFINE_BOOL(shortcut_strings_with_stack, true,
             "Shortcut Strings during GC with stack")
 DEFINE_BOOL(stress_compaction, false,
@@ -1917,6 +1969,10 @@ DEFINE_BOOL(profile_deserialization, false,
             "Print the time it takes to deserialize the snapshot.")
 DEFINE_BOOL(serialization_statistics, false,
             "Collect statistics on serialized objects.")
+DEFINE_BOOL(code_cache_tiering_hints, false,
+            "Record in the code cache which functions were optimized by "
+            "Turbofan, and tier these functions up early after deserializing "
+            "the code cache.")
 // Regexp
 DEFINE_BOOL(regexp_optimization, true, "generate optimized regexp code")
 DEFINE_BOOL(regexp_interpret_all, false, "interpret all regexp code")
@@ -2351,6 +2407,7 @@ DEFINE_NEG_IMPLICATION(single_threaded, lazy_compile_dispatcher)
 DEFINE_NEG_IMPLICATION(single_threaded,
                        parallel_compile_tasks_for_eager_toplevel)
 DEFINE_NEG_IMPLICATION(single_threaded, parallel_compile_tasks_for_lazy)
+DEFINE_NEG_IMPLICATION(single_threaded, turbo_parallel_register_allocation)
 
 //
 // Parallel and concurrent GC (Orinoco) related flags.
@@ -4,6 +4,7 @@
 
 #include "src/heap/array-buffer-sweeper.h"
 
+#include <algorithm>
 #include <atomic>
 #include <memory>
 
@@ -50,6 +51,19 @@ void ArrayBufferList::Append(ArrayBufferList* list) {
   *list = ArrayBufferList();
 }
 
+ArrayBufferList ArrayBufferList::TakeFront(size_t count) {
+  ArrayBufferList front;
+  while (head_ && count > 0) {
+    ArrayBufferExtension* current = head_;
+    head_ = current->next();
+    bytes_ -= std::min(bytes_, current->accounting_length());
+    front.Append(current);
+    count--;
+  }
+  if (head_ == nullptr) *this = ArrayBufferList();
+  return front;
+}
+
 bool ArrayBufferList::ContainsSlow(ArrayBufferExtension* extension) const {
   for (ArrayBufferExtension* current = head_; current;
        current = current->next()) {
@@ -92,6 +106,8 @@ struct ArrayBufferSweeper::SweepingJob final {
   std::atomic<SweepingState> state_;
   ArrayBufferList young_;
   ArrayBufferList old_;
+  // Dead extensions found by sweeping.
+  ArrayBufferList dead_;
   const SweepingType type_;
   std::atomic<size_t> freed_bytes_{0};
 
@@ -102,10 +118,19 @@ ArrayBufferSweeper::ArrayBufferSweeper(Heap* heap) : heap_(heap) {}
 
 ArrayBufferSweeper::~ArrayBufferSweeper() {
   EnsureFinished();
+  WaitForReleaseTasks();
+  ReleaseDeadExtensions();
   ReleaseAll(&old_);
   ReleaseAll(&young_);
 }
 
+void ArrayBufferSweeper::WaitForReleaseTasks() {
+  base::MutexGuard guard(&release_mutex_);
+  while (active_release_tasks_ > 0) {
+    release_finished_.Wait(&release_mutex_);
+  }
+}
+
 void ArrayBufferSweeper::EnsureFinished() {
   if (!sweeping_in_progress()) return;
 
@@ -114,8 +139,11 @@ void ArrayBufferSweeper::EnsureFinished() {
 
   switch (abort_result) {
     case TryAbortResult::kTaskAborted:
-      // Task has not run, so we need to run it synchronously here.
-      job_->Sweep();
+      // Task has not run, so we need to run it synchronously here. No task
+      // is going to drain the release queue for this cycle, so dead
+      // extensions are freed right away.
+      DoSweep();
+      ReleaseDeadExtensions();
       break;
     case TryAbortResult::kTaskRemoved:
       // Task was removed, but did actually run, just ensure we are in the right
@@ -161,15 +189,28 @@ void ArrayBufferSweeper::RequestSweep(SweepingType type) {
               ? GCTracer::Scope::BACKGROUND_YOUNG_ARRAY_BUFFER_SWEEP
               : GCTracer::Scope::BACKGROUND_FULL_ARRAY_BUFFER_SWEEP;
       TRACE_GC_EPOCH(heap_->tracer(), scope_id, ThreadKind::kBackground);
-      base::MutexGuard guard(&sweeping_mutex_);
-      job_->Sweep();
-      job_finished_.NotifyAll();
+      {
+        base::MutexGuard guard(&sweeping_mutex_);
+        {
+          // Registered before sweeping finishes so that the destructor cannot
+          // miss this task after EnsureFinished().
+          base::MutexGuard release_guard(&release_mutex_);
+          active_release_tasks_++;
+        }
+        DoSweep();
+        job_finished_.NotifyAll();
+      }
+      // `job_` may be finalized from here on. Only the release queue is used.
+      ReleaseDeadExtensions();
+      base::MutexGuard release_guard(&release_mutex_);
+      if (--active_release_tasks_ == 0) release_finished_.NotifyAll();
     });
     job_->id_ = task->id();
     V8::GetCurrentPlatform()->CallOnWorkerThread(std::move(task));
   } else {
-    job_->Sweep();
+    DoSweep();
     Finalize();
+    ReleaseDeadExtensions();
   }
 }
 
@@ -191,6 +232,15 @@ void ArrayBufferSweeper::Prepare(SweepingType type) {
   DCHECK(sweeping_in_progress());
 }
 
+void ArrayBufferSweeper::DoSweep() {
+  job_->Sweep();
+  {
+    base::MutexGuard guard(&release_mutex_);
+    release_queue_.Append(&job_->dead_);
+  }
+  job_->state_ = SweepingState::kDone;
+}
+
 void ArrayBufferSweeper::Finalize() {
   DCHECK(sweeping_in_progress());
   CHECK_EQ(job_->state_, SweepingState::kDone);
@@ -203,6 +253,18 @@ void ArrayBufferSweeper::Finalize() {
   DCHECK(!sweeping_in_progress());
 }
 
+void ArrayBufferSweeper::ReleaseDeadExtensions() {
+  while (true) {
+    ArrayBufferList batch;
+    {
+      base::MutexGuard guard(&release_mutex_);
+      batch = release_queue_.TakeFront(kReleaseBatchSize);
+    }
+    if (batch.IsEmpty()) return;
+    ReleaseAll(&batch);
+  }
+}
+
 void ArrayBufferSweeper::ReleaseAll(ArrayBufferList* list) {
   ArrayBufferExtension* current = list->head_;
   while (current) {
@@ -280,7 +342,6 @@ void ArrayBufferSweeper::SweepingJob::Sweep() {
       SweepFull();
       break;
   }
-  state_ = SweepingState::kDone;
 }
 
 void ArrayBufferSweeper::SweepingJob::SweepFull() {
@@ -302,7 +363,7 @@ ArrayBufferList ArrayBufferSweeper::SweepingJob::SweepListFull(
 
     if (!current->IsMarked()) {
       const size_t bytes = current->accounting_length();
-      delete current;
+      dead_.Append(current);
       if (bytes) freed_bytes_.fetch_add(bytes, std::memory_order_relaxed);
     } else {
       current->Unmark();
@@ -328,7 +389,7 @@ void ArrayBufferSweeper::SweepingJob::SweepYoung() {
 
     if (!current->IsYoungMarked()) {
       size_t bytes = current->accounting_length();
-      delete current;
+      dead_.Append(current);
       if (bytes) freed_bytes_.fetch_add(bytes, std::memory_order_relaxed);
     } else if (current->IsYoungPromoted()) {
       current->YoungUnmark();
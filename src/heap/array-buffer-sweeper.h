@@ -28,6 +28,10 @@ struct ArrayBufferList final {
   void Append(ArrayBufferExtension* extension);
   void Append(ArrayBufferList* list);
 
+  // Removes up to `count` extensions from the front of this list and returns
+  // them as a new list.
+  ArrayBufferList TakeFront(size_t count);
+
   V8_EXPORT_PRIVATE bool ContainsSlow(ArrayBufferExtension* extension) const;
 
  private:
@@ -43,16 +47,29 @@ struct ArrayBufferList final {
 
 // The ArrayBufferSweeper iterates and deletes ArrayBufferExtensions
 // concurrently to the application.
+//
+// Sweeping only unlinks dead extensions and subtracts their bytes from the
+// external memory counters. The dead extensions, and with them the backing
+// stores, are then deleted in batches from a release queue, on the sweeping
+// task if sweeping is concurrent. Waiting for sweeping to finish thus never
+// waits for the backing stores to be freed.
 class ArrayBufferSweeper final {
  public:
   enum class SweepingType { kYoung, kFull };
 
+  // Number of extensions deleted per acquisition of the release queue lock.
+  static constexpr size_t kReleaseBatchSize = 64;
+
   explicit ArrayBufferSweeper(Heap* heap);
   ~ArrayBufferSweeper();
 
   void RequestSweep(SweepingType sweeping_type);
   void EnsureFinished();
 
+  // Waits until no sweeping task is releasing dead extensions anymore. Must
+  // be called after EnsureFinished() for the release queue to be empty.
+  void WaitForReleaseTasks();
+
   // Track the given ArrayBufferExtension for the given JSArrayBuffer.
   void Append(JSArrayBuffer object, ArrayBufferExtension* extension);
 
@@ -83,8 +100,13 @@ class ArrayBufferSweeper final {
   void DecrementExternalMemoryCounters(size_t bytes);
 
   void Prepare(SweepingType type);
+  // Sweeps the lists of `job_` and moves dead extensions to the release queue.
+  void DoSweep();
   void Finalize();
 
+  // Deletes the extensions in the release queue. May be called from any
+  // thread.
+  void ReleaseDeadExtensions();
   void ReleaseAll(ArrayBufferList* extension);
 
   Heap* const heap_;
@@ -93,6 +115,15 @@ class ArrayBufferSweeper final {
   base::ConditionVariable job_finished_;
   ArrayBufferList young_;
   ArrayBufferList old_;
+
+  base::Mutex release_mutex_;
+  base::ConditionVariable release_finished_;
+  // Dead extensions that were already subtracted from the external memory
+  // counters but not yet deleted. Guarded by `release_mutex_`.
+  ArrayBufferList release_queue_;
+  // Number of sweeping tasks that may still release extensions. Guarded by
+  // `release_mutex_`.
+  int active_release_tasks_ = 0;
 };
 
 }  // namespace internal
@@ -33,6 +33,11 @@ class ActiveSystemPages final {
   // can't add pages. Returns the number of removed pages.
   V8_EXPORT_PRIVATE size_t Reduce(ActiveSystemPages updated_value);
 
+  // Removes the pages that are fully contained in this memory range. Returns
+  // the number of removed pages.
+  V8_EXPORT_PRIVATE size_t Remove(size_t start, size_t end,
+                                  size_t page_size_bits);
+
   // Removes all pages. Returns the number of removed pages.
   V8_EXPORT_PRIVATE size_t Clear();
 
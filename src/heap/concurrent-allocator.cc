@@ -4,6 +4,8 @@
 
 #include "src/heap/concurrent-allocator.h"
 
+#include <algorithm>
+
 #include "src/common/globals.h"
 #include "src/execution/isolate.h"
 #include "src/handles/persistent-handles.h"
@@ -89,6 +91,11 @@ ConcurrentAllocator::ConcurrentAllocator(LocalHeap* local_heap,
 }
 
 void ConcurrentAllocator::FreeLinearAllocationArea() {
+  FreeLab();
+  max_lab_size_ = kMaxLabSize;
+}
+
+void ConcurrentAllocator::FreeLab() {
   // The code page of the linear allocation area needs to be unprotected
   // because we are going to write a filler into that memory area below.
   base::Optional<CodePageMemoryModificationScope> optional_scope;
@@ -155,12 +162,15 @@ AllocationResult ConcurrentAllocator::AllocateInLabSlow(
 }
 
 bool ConcurrentAllocator::AllocateLab(AllocationOrigin origin) {
-  auto result = AllocateFromSpaceFreeList(kMinLabSize, kMaxLabSize, origin);
+  auto result = AllocateFromSpaceFreeList(kMinLabSize, max_lab_size_, origin);
   if (!result) return false;
 
   owning_heap()->StartIncrementalMarkingIfAllocationLimitIsReachedBackground();
 
-  FreeLinearAllocationArea();
+  FreeLab();
+  if (v8_flags.concurrent_allocator_adaptive_lab_size) {
+    max_lab_size_ = std::min(2 * max_lab_size_, kMaxAdaptiveLabSize);
+  }
 
   Address lab_start = result->first;
   Address lab_end = lab_start + result->second;
@@ -43,6 +43,9 @@ class ConcurrentAllocator {
   static constexpr int kMinLabSize = 4 * KB;
   static constexpr int kMaxLabSize = 32 * KB;
   static constexpr int kMaxLabObjectSize = 2 * KB;
+  // Upper bound for LABs that grew because of repeated refills, see
+  // AllocateLab().
+  static constexpr int kMaxAdaptiveLabSize = 128 * KB;
 
   ConcurrentAllocator(LocalHeap* local_heap, PagedSpace* space,
                       Context context);
@@ -91,6 +94,9 @@ class ConcurrentAllocator {
   // Resets the LAB.
   void ResetLab() { lab_ = LinearAllocationArea(kNullAddress, kNullAddress); }
 
+  // Gives back the current LAB without resetting the adaptive LAB size.
+  void FreeLab();
+
   // Installs a filler object between the LABs top and limit pointers.
   void MakeLabIterable();
 
@@ -102,7 +108,13 @@ class ConcurrentAllocator {
   PagedSpace* const space_;
   Heap* const owning_heap_;
   LinearAllocationArea lab_;
+  // Maximum size requested for the next LAB. Doubles on every refill up to
+  // kMaxAdaptiveLabSize so that allocation-heavy threads take the space mutex
+  // less often, and is reset whenever the LAB is freed for a GC.
+  int max_lab_size_ = kMaxLabSize;
   const Context context_;
+
+  friend class ConcurrentAllocatorTest;
 };
 
 }  // namespace internal
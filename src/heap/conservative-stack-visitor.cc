@@ -4,6 +4,8 @@
 
 #include "src/heap/conservative-stack-visitor.h"
 
+#include <algorithm>
+
 #include "src/execution/isolate-inl.h"
 #include "src/heap/mark-compact.h"
 #include "src/objects/visitors.h"
@@ -21,29 +23,40 @@ ConservativeStackVisitor::ConservativeStackVisitor(Isolate* isolate,
 
 void ConservativeStackVisitor::VisitPointer(const void* pointer) {
   auto address = reinterpret_cast<Address>(const_cast<void*>(pointer));
-  VisitConservativelyIfPointer(address);
+  AddCandidate(address);
 #ifdef V8_COMPRESS_POINTERS
   V8HeapCompressionScheme::ProcessIntermediatePointers(
-      isolate_, address,
-      [this](Address ptr) { VisitConservativelyIfPointer(ptr); });
+      isolate_, address, [this](Address ptr) { AddCandidate(ptr); });
 #endif  // V8_COMPRESS_POINTERS
 }
 
-void ConservativeStackVisitor::VisitConservativelyIfPointer(Address address) {
-  Address base_ptr;
+void ConservativeStackVisitor::AddCandidate(Address address) {
+  if (address == kNullAddress) return;
+  candidates_.push_back(address);
+}
+
+void ConservativeStackVisitor::VisitCollectedPointers() {
+  // Sorting allows resolving all pointers into the same page with a single
+  // page lookup and a single forward walk over its objects.
+  std::sort(candidates_.begin(), candidates_.end());
+  candidates_.erase(std::unique(candidates_.begin(), candidates_.end()),
+                    candidates_.end());
+  std::vector<Address> base_ptrs;
 #ifdef V8_ENABLE_INNER_POINTER_RESOLUTION_MB
-  base_ptr = isolate_->heap()->mark_compact_collector()->FindBasePtrForMarking(
-      address);
+  isolate_->heap()->mark_compact_collector()->FindBasePtrsForMarking(
+      candidates_, &base_ptrs);
 #else
 #error "Some inner pointer resolution mechanism is needed"
 #endif  // V8_ENABLE_INNER_POINTER_RESOLUTION_MB
-  if (base_ptr == kNullAddress) return;
-  HeapObject obj = HeapObject::FromAddress(base_ptr);
-  Object root = obj;
-  delegate_->VisitRootPointer(Root::kHandleScope, nullptr,
-                              FullObjectSlot(&root));
-  // Check that the delegate visitor did not modify the root slot.
-  DCHECK_EQ(root, obj);
+  candidates_.clear();
+  for (Address base_ptr : base_ptrs) {
+    HeapObject obj = HeapObject::FromAddress(base_ptr);
+    Object root = obj;
+    delegate_->VisitRootPointer(Root::kHandleScope, nullptr,
+                                FullObjectSlot(&root));
+    // Check that the delegate visitor did not modify the root slot.
+    DCHECK_EQ(root, obj);
+  }
 }
 
 }  // namespace internal
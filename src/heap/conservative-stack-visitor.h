@@ -5,6 +5,8 @@
 #ifndef V8_HEAP_CONSERVATIVE_STACK_VISITOR_H_
 #define V8_HEAP_CONSERVATIVE_STACK_VISITOR_H_
 
+#include <vector>
+
 #include "include/v8-internal.h"
 #include "src/heap/base/stack.h"
 
@@ -13,18 +15,27 @@ namespace internal {
 
 class RootVisitor;
 
+// Collects all words of the stack that may point into the heap and resolves
+// them in one batch. Stack::IteratePointers() must be followed by a call to
+// VisitCollectedPointers() to report the objects to the delegate.
 class V8_EXPORT_PRIVATE ConservativeStackVisitor
     : public ::heap::base::StackVisitor {
  public:
   ConservativeStackVisitor(Isolate* isolate, RootVisitor* delegate);
+  ~ConservativeStackVisitor() override { DCHECK(candidates_.empty()); }
 
   void VisitPointer(const void* pointer) final;
 
+  // Resolves the collected pointers to objects and visits each of them once.
+  void VisitCollectedPointers();
+
  private:
-  void VisitConservativelyIfPointer(Address address);
+  void AddCandidate(Address address);
 
   Isolate* isolate_ = nullptr;
   RootVisitor* delegate_ = nullptr;
+  // Possibly inner pointers collected from the stack.
+  std::vector<Address> candidates_;
 };
 
 }  // namespace internal
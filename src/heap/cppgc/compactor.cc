@@ -4,12 +4,16 @@
 
 #include "src/heap/cppgc/compactor.h"
 
+#include <atomic>
 #include <map>
 #include <numeric>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
-#include "include/cppgc/macros.h"
+#include "include/cppgc/platform.h"
+#include "src/base/platform/mutex.h"
 #include "src/heap/cppgc/compaction-worklists.h"
 #include "src/heap/cppgc/globals.h"
 #include "src/heap/cppgc/heap-base.h"
@@ -35,17 +39,31 @@ static constexpr size_t kFreeListSizeThreshold = 512 * kKB;
 //
 // The MovableReferences object is created and maintained for the lifetime
 // of one heap compaction-enhanced GC.
+//
+// Spaces may be compacted in parallel. Relocating objects of one space only
+// ever touches slots outside of compactable spaces or interior slots of the
+// same space. Interior slots in other compactable spaces may be moved
+// concurrently and are updated after all spaces have been compacted.
 class MovableReferences final {
   using MovableReference = CompactionWorklists::MovableReference;
 
  public:
+  // Interior slots in other spaces along with the new value they should
+  // point to.
+  using DeferredSlots = std::vector<std::pair<MovableReference*, Address>>;
+
   explicit MovableReferences(HeapBase& heap) : heap_(heap) {}
 
   // Adds a slot for compaction. Filters slots in dead objects.
   void AddOrFilter(MovableReference*);
 
-  // Relocates a backing store |from| -> |to|.
-  void Relocate(Address from, Address to);
+  // Relocates a backing store |from| -> |to|. Slots that cannot be updated
+  // yet are added to |deferred_slots|.
+  void Relocate(Address from, Address to, DeferredSlots& deferred_slots);
+
+  // Updates slots deferred by Relocate(). Must only be called once all spaces
+  // are compacted.
+  void UpdateDeferredSlots(const DeferredSlots& deferred_slots);
 
   // Relocates interior slots in a backing store that is moved |from| -> |to|.
   void RelocateInteriorReferences(Address from, Address to, size_t size);
@@ -70,9 +88,13 @@ class MovableReferences final {
   // - Upon moving an object this value is adjusted accordingly.
   std::map<MovableReference*, Address> interior_movable_references_;
 
+  // Interior slots that point to objects in a different compactable space.
+  std::unordered_set<MovableReference*> cross_space_interior_slots_;
+
 #if DEBUG
   // The following two collections are used to allow refer back from a slot to
   // an already moved object.
+  v8::base::Mutex moved_objects_mutex_;
   std::unordered_set<const void*> moved_objects_;
   std::unordered_map<MovableReference*, MovableReference>
       interior_slot_to_object_;
@@ -129,14 +151,21 @@ void MovableReferences::AddOrFilter(MovableReference* slot) {
   CHECK_EQ(interior_movable_references_.end(),
            interior_movable_references_.find(slot));
   interior_movable_references_.emplace(slot, nullptr);
+  if (&slot_page->space() != &value_page->space()) {
+    cross_space_interior_slots_.insert(slot);
+  }
 #if DEBUG
   interior_slot_to_object_.emplace(slot, slot_header.ObjectStart());
 #endif  // DEBUG
 }
 
-void MovableReferences::Relocate(Address from, Address to) {
+void MovableReferences::Relocate(Address from, Address to,
+                                 DeferredSlots& deferred_slots) {
 #if DEBUG
-  moved_objects_.insert(from);
+  {
+    v8::base::MutexGuard guard(&moved_objects_mutex_);
+    moved_objects_.insert(from);
+  }
 #endif  // DEBUG
 
   // Interior slots always need to be processed for moved objects.
@@ -164,6 +193,11 @@ void MovableReferences::Relocate(Address from, Address to) {
   MovableReference* slot = it->second;
   auto interior_it = interior_movable_references_.find(slot);
   if (interior_it != interior_movable_references_.end()) {
+    if (cross_space_interior_slots_.count(slot)) {
+      // The object containing the slot may be moved concurrently.
+      deferred_slots.emplace_back(slot, to);
+      return;
+    }
     MovableReference* slot_location =
         reinterpret_cast<MovableReference*>(interior_it->second);
     if (!slot_location) {
@@ -172,6 +206,7 @@ void MovableReferences::Relocate(Address from, Address to) {
       // Check that the containing object has not been moved yet.
       auto reverse_it = interior_slot_to_object_.find(slot);
       DCHECK_NE(interior_slot_to_object_.end(), reverse_it);
+      v8::base::MutexGuard guard(&moved_objects_mutex_);
       DCHECK_EQ(moved_objects_.end(), moved_objects_.find(reverse_it->second));
 #endif  // DEBUG
     } else {
@@ -186,6 +221,21 @@ void MovableReferences::Relocate(Address from, Address to) {
   *slot = to;
 }
 
+void MovableReferences::UpdateDeferredSlots(
+    const DeferredSlots& deferred_slots) {
+  for (const auto& [slot, value] : deferred_slots) {
+    auto interior_it = interior_movable_references_.find(slot);
+    DCHECK_NE(interior_movable_references_.end(), interior_it);
+    // The slot was moved along with its containing object unless that object
+    // stayed in place.
+    MovableReference* slot_location =
+        interior_it->second
+            ? reinterpret_cast<MovableReference*>(interior_it->second)
+            : slot;
+    *slot_location = value;
+  }
+}
+
 void MovableReferences::RelocateInteriorReferences(Address from, Address to,
                                                    size_t size) {
   // |from| is a valid address for a slot.
@@ -218,13 +268,72 @@ void MovableReferences::RelocateInteriorReferences(Address from, Address to,
   }
 }
 
+enum class StickyBits : uint8_t {
+  kDisabled,
+  kEnabled,
+};
+
+// Compaction generally follows Jonker's algorithm for fast garbage
+// compaction. Compaction is performed in-place, sliding objects down over
+// unused holes for a smaller heap page footprint and improved locality. A
+// "compaction pointer" is consequently kept, pointing to the next available
+// address to move objects down to. It will belong to one of the already
+// compacted pages for this space, but as compaction proceeds, it will not
+// belong to the same page as the one being currently compacted.
+//
+// The compaction pointer is represented by the
+// |(current_page_, used_bytes_in_current_page_)| pair, with
+// |used_bytes_in_current_page_| being the offset into |current_page_|, making
+// up the next available location. When the compaction of an arena page causes
+// the compaction pointer to exhaust the current page it is compacting into,
+// page compaction will advance the current page of the compaction
+// pointer, as well as the allocation point.
+//
+// By construction, the page compaction can be performed without having
+// to allocate any new pages. So to arrange for the page compaction's
+// supply of freed, available pages, we chain them together after each
+// has been "compacted from". The page compaction will then reuse those
+// as needed, and once finished, the chained, available pages can be
+// released back to the OS.
+//
+// To ease the passing of the compaction state when iterating over an
+// arena's pages, package it up into a |CompactionState|. Each space is
+// compacted by a single thread but different spaces may be compacted in
+// parallel.
 class CompactionState final {
-  CPPGC_STACK_ALLOCATED();
   using Pages = std::vector<NormalPage*>;
 
  public:
-  CompactionState(NormalPageSpace* space, MovableReferences& movable_references)
-      : space_(space), movable_references_(movable_references) {}
+  CompactionState(NormalPageSpace* space, NormalPageSpace::Pages pages,
+                  MovableReferences& movable_references)
+      : space_(space),
+        pages_(std::move(pages)),
+        movable_references_(movable_references) {}
+
+  CompactionState(CompactionState&&) V8_NOEXCEPT = default;
+  CompactionState(const CompactionState&) = delete;
+  CompactionState& operator=(const CompactionState&) = delete;
+
+  // Compacts all pages of the space. Does not call into the embedder and may
+  // be called from any thread.
+  void CompactPages(StickyBits sticky_bits);
+
+  // Releases pages that are left empty after compaction. Must be called on
+  // the mutator thread.
+  void ReleaseAvailablePages() {
+    for (NormalPage* page : available_pages_) {
+      SetMemoryInaccessible(page->PayloadStart(), page->PayloadSize());
+      NormalPage::Destroy(page);
+    }
+    available_pages_.clear();
+  }
+
+  const MovableReferences::DeferredSlots& deferred_slots() const {
+    return deferred_slots_;
+  }
+
+ private:
+  void CompactPage(NormalPage* page, StickyBits sticky_bits);
 
   void AddPage(NormalPage* page) {
     DCHECK_EQ(space_, &page->space());
@@ -257,7 +366,8 @@ class CompactionState final {
       else
         memcpy(compact_frontier, header, size);
       movable_references_.Relocate(header + sizeof(HeapObjectHeader),
-                                   compact_frontier + sizeof(HeapObjectHeader));
+                                   compact_frontier + sizeof(HeapObjectHeader),
+                                   deferred_slots_);
     }
     current_page_->object_start_bitmap().SetBit(compact_frontier);
     used_bytes_in_current_page_ += size;
@@ -266,19 +376,12 @@ class CompactionState final {
 
   void FinishCompactingSpace() {
     // If the current page hasn't been allocated into, add it to the available
-    // list, for subsequent release below.
+    // list, for subsequent release.
     if (used_bytes_in_current_page_ == 0) {
       available_pages_.push_back(current_page_);
     } else {
       ReturnCurrentPageToSpace();
     }
-
-    // Return remaining available pages to the free page pool, decommitting
-    // them from the pagefile.
-    for (NormalPage* page : available_pages_) {
-      SetMemoryInaccessible(page->PayloadStart(), page->PayloadSize());
-      NormalPage::Destroy(page);
-    }
   }
 
   void FinishCompactingPage(NormalPage* page) {
@@ -295,7 +398,6 @@ class CompactionState final {
     page->object_start_bitmap().MarkAsFullyPopulated();
   }
 
- private:
   void ReturnCurrentPageToSpace() {
     DCHECK_EQ(space_, &current_page_->space());
     space_->AddPage(current_page_);
@@ -312,7 +414,10 @@ class CompactionState final {
   }
 
   NormalPageSpace* space_;
+  // Pages of |space_| that are compacted.
+  NormalPageSpace::Pages pages_;
   MovableReferences& movable_references_;
+  MovableReferences::DeferredSlots deferred_slots_;
   // Page into which compacted object will be written to.
   NormalPage* current_page_ = nullptr;
   // Offset into |current_page_| to the next free address.
@@ -322,14 +427,18 @@ class CompactionState final {
   Pages available_pages_;
 };
 
-enum class StickyBits : uint8_t {
-  kDisabled,
-  kEnabled,
-};
+void CompactionState::CompactPages(StickyBits sticky_bits) {
+  if (pages_.empty()) return;
+  for (BasePage* page : pages_) {
+    // Large objects do not belong to this arena.
+    CompactPage(NormalPage::From(page), sticky_bits);
+  }
+  FinishCompactingSpace();
+  // Sweeping will verify object start bitmap of compacted space.
+}
 
-void CompactPage(NormalPage* page, CompactionState& compaction_state,
-                 StickyBits sticky_bits) {
-  compaction_state.AddPage(page);
+void CompactionState::CompactPage(NormalPage* page, StickyBits sticky_bits) {
+  AddPage(page);
 
   page->object_start_bitmap().Clear();
 
@@ -349,14 +458,10 @@ void CompactPage(NormalPage* page, CompactionState& compaction_state,
     }
 
     if (!header->IsMarked()) {
-      // Compaction is currently launched only from AtomicPhaseEpilogue, so it's
-      // guaranteed to be on the mutator thread - no need to postpone
-      // finalization.
-      header->Finalize();
-
-      // As compaction is under way, leave the freed memory accessible
-      // while compacting the rest of the page. We just zap the payload
-      // to catch out other finalizers trying to access it.
+      // Dead objects have already been finalized on the mutator thread. As
+      // compaction is under way, leave the freed memory accessible while
+      // compacting the rest of the page. We just zap the payload to catch out
+      // other finalizers trying to access it.
 #if DEBUG || defined(V8_USE_MEMORY_SANITIZER) || \
     defined(V8_USE_ADDRESS_SANITIZER)
       ZapMemory(header, size);
@@ -375,17 +480,17 @@ void CompactPage(NormalPage* page, CompactionState& compaction_state,
     // Potentially unpoison the live object as well as it is the source of
     // the copy.
     ASAN_UNPOISON_MEMORY_REGION(header->ObjectStart(), header->ObjectSize());
-    compaction_state.RelocateObject(page, header_address, size);
+    RelocateObject(page, header_address, size);
     header_address += size;
   }
 
-  compaction_state.FinishCompactingPage(page);
+  FinishCompactingPage(page);
 }
 
-void CompactSpace(NormalPageSpace* space, MovableReferences& movable_references,
-                  StickyBits sticky_bits) {
-  using Pages = NormalPageSpace::Pages;
-
+// Removes all pages from |space| and finalizes their dead objects. Compaction
+// is launched from AtomicPhaseEpilogue, so this is guaranteed to be on the
+// mutator thread and finalization does not need to be postponed.
+NormalPageSpace::Pages PrepareSpaceForCompaction(NormalPageSpace* space) {
 #ifdef V8_USE_ADDRESS_SANITIZER
   UnmarkedObjectsPoisoner().Traverse(*space);
 #endif  // V8_USE_ADDRESS_SANITIZER
@@ -394,44 +499,55 @@ void CompactSpace(NormalPageSpace* space, MovableReferences& movable_references,
 
   space->free_list().Clear();
 
-  // Compaction generally follows Jonker's algorithm for fast garbage
-  // compaction. Compaction is performed in-place, sliding objects down over
-  // unused holes for a smaller heap page footprint and improved locality. A
-  // "compaction pointer" is consequently kept, pointing to the next available
-  // address to move objects down to. It will belong to one of the already
-  // compacted pages for this space, but as compaction proceeds, it will not
-  // belong to the same page as the one being currently compacted.
-  //
-  // The compaction pointer is represented by the
-  // |(current_page_, used_bytes_in_current_page_)| pair, with
-  // |used_bytes_in_current_page_| being the offset into |current_page_|, making
-  // up the next available location. When the compaction of an arena page causes
-  // the compaction pointer to exhaust the current page it is compacting into,
-  // page compaction will advance the current page of the compaction
-  // pointer, as well as the allocation point.
-  //
-  // By construction, the page compaction can be performed without having
-  // to allocate any new pages. So to arrange for the page compaction's
-  // supply of freed, available pages, we chain them together after each
-  // has been "compacted from". The page compaction will then reuse those
-  // as needed, and once finished, the chained, available pages can be
-  // released back to the OS.
-  //
-  // To ease the passing of the compaction state when iterating over an
-  // arena's pages, package it up into a |CompactionState|.
+  NormalPageSpace::Pages pages = space->RemoveAllPages();
+  for (BasePage* page : pages) {
+    NormalPage* normal_page = NormalPage::From(page);
+    for (Address header_address = normal_page->PayloadStart();
+         header_address < normal_page->PayloadEnd();) {
+      HeapObjectHeader* header =
+          reinterpret_cast<HeapObjectHeader*>(header_address);
+      if (!header->IsFree() && !header->IsMarked()) header->Finalize();
+      header_address += header->AllocatedSize();
+    }
+  }
+  return pages;
+}
 
-  Pages pages = space->RemoveAllPages();
-  if (pages.empty()) return;
+// Compacts spaces in parallel. Every space is claimed by exactly one thread.
+class CompactSpacesJobTask final : public cppgc::JobTask {
+ public:
+  CompactSpacesJobTask(HeapBase& heap,
+                       std::vector<CompactionState>& compaction_states,
+                       StickyBits sticky_bits)
+      : heap_(heap),
+        compaction_states_(compaction_states),
+        sticky_bits_(sticky_bits) {}
+
+  void Run(cppgc::JobDelegate* delegate) final {
+    StatsCollector::EnabledConcurrentScope stats_scope(
+        heap_.stats_collector(), StatsCollector::kConcurrentCompact);
+    while (!delegate->ShouldYield()) {
+      const size_t index =
+          next_space_index_.fetch_add(1, std::memory_order_relaxed);
+      if (index >= compaction_states_.size()) return;
+      compaction_states_[index].CompactPages(sticky_bits_);
+    }
+  }
 
-  CompactionState compaction_state(space, movable_references);
-  for (BasePage* page : pages) {
-    // Large objects do not belong to this arena.
-    CompactPage(NormalPage::From(page), compaction_state, sticky_bits);
+  size_t GetMaxConcurrency(size_t /* active_worker_count */) const final {
+    const size_t next_space_index =
+        next_space_index_.load(std::memory_order_relaxed);
+    return next_space_index < compaction_states_.size()
+               ? compaction_states_.size() - next_space_index
+               : 0;
   }
 
-  compaction_state.FinishCompactingSpace();
-  // Sweeping will verify object start bitmap of compacted space.
-}
+ private:
+  HeapBase& heap_;
+  std::vector<CompactionState>& compaction_states_;
+  const StickyBits sticky_bits_;
+  std::atomic<size_t> next_space_index_{0};
+};
 
 size_t UpdateHeapResidency(const std::vector<NormalPageSpace*>& spaces) {
   return std::accumulate(spaces.cbegin(), spaces.cend(), 0u,
@@ -513,11 +629,36 @@ Compactor::CompactableSpaceHandling Compactor::CompactSpacesIfEnabled() {
   compaction_worklists_.reset();
 
   const bool young_gen_enabled = heap_.heap()->generational_gc_supported();
+  const StickyBits sticky_bits =
+      young_gen_enabled ? StickyBits::kEnabled : StickyBits::kDisabled;
 
+  std::vector<CompactionState> compaction_states;
+  compaction_states.reserve(compactable_spaces_.size());
   for (NormalPageSpace* space : compactable_spaces_) {
-    CompactSpace(
-        space, movable_references,
-        young_gen_enabled ? StickyBits::kEnabled : StickyBits::kDisabled);
+    NormalPageSpace::Pages pages = PrepareSpaceForCompaction(space);
+    if (pages.empty()) continue;
+    compaction_states.emplace_back(space, std::move(pages), movable_references);
+  }
+
+  if (compaction_states.size() > 1 &&
+      heap_.heap()->marking_support() ==
+          cppgc::Heap::MarkingType::kIncrementalAndConcurrent) {
+    // The mutator thread contributes to the job while joining.
+    heap_.heap()
+        ->platform()
+        ->PostJob(cppgc::TaskPriority::kUserBlocking,
+                  std::make_unique<CompactSpacesJobTask>(
+                      *heap_.heap(), compaction_states, sticky_bits))
+        ->Join();
+  } else {
+    for (CompactionState& compaction_state : compaction_states) {
+      compaction_state.CompactPages(sticky_bits);
+    }
+  }
+
+  for (CompactionState& compaction_state : compaction_states) {
+    movable_references.UpdateDeferredSlots(compaction_state.deferred_slots());
+    compaction_state.ReleaseAvailablePages();
   }
 
   enable_for_next_gc_for_testing_ = false;
@@ -232,10 +232,10 @@ Address PageBackend::TryAllocateLargePageMemory(size_t size) {
 void PageBackend::FreeLargePageMemory(Address writeable_base) {
   v8::base::MutexGuard guard(&mutex_);
   PageMemoryRegion* pmr = page_memory_region_tree_.Lookup(writeable_base);
+  CHECK_NOT_NULL(pmr);
   page_memory_region_tree_.Remove(pmr);
-  auto size = large_page_memory_regions_.erase(pmr);
-  USE(size);
-  DCHECK_EQ(1u, size);
+  const size_t size = large_page_memory_regions_.erase(pmr);
+  CHECK_EQ(1u, size);
 }
 
 }  // namespace internal
@@ -65,7 +65,9 @@ namespace internal {
   V(ConcurrentSweep)                                 \
   V(ConcurrentWeakCallback)
 
-#define CPPGC_FOR_ALL_CONCURRENT_SCOPES(V) V(ConcurrentMarkProcessEphemerons)
+#define CPPGC_FOR_ALL_CONCURRENT_SCOPES(V) \
+  V(ConcurrentCompact)                    \
+  V(ConcurrentMarkProcessEphemerons)
 
 // Sink for various time and memory statistics.
 class V8_EXPORT_PRIVATE StatsCollector final {
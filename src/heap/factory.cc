@@ -2165,6 +2165,15 @@ Handle<JSObject> Factory::CopyJSObjectWithAllocationSite(
     InitializeAllocationMemento(alloc_memento, *site);
   }
 
+  // With --allocation-site-pretenuring-decay the clone itself stays young so
+  // that it keeps carrying a memento and the site keeps receiving feedback,
+  // but the backing stores of a tenured site are expected to survive and are
+  // allocated in old space right away.
+  AllocationType backing_store_allocation =
+      site.is_null() || !v8_flags.allocation_site_pretenuring_decay
+          ? AllocationType::kYoung
+          : site->GetAllocationType();
+
   SLOW_DCHECK(clone->GetElementsKind() == source->GetElementsKind());
   FixedArrayBase elements = source->elements();
   // Update elements if necessary.
@@ -2174,9 +2183,11 @@ Handle<JSObject> Factory::CopyJSObjectWithAllocationSite(
       elem = elements;
     } else if (source->HasDoubleElements()) {
       elem = *CopyFixedDoubleArray(
-          handle(FixedDoubleArray::cast(elements), isolate()));
+          handle(FixedDoubleArray::cast(elements), isolate()),
+          backing_store_allocation);
     } else {
-      elem = *CopyFixedArray(handle(FixedArray::cast(elements), isolate()));
+      elem = *CopyFixedArray(handle(FixedArray::cast(elements), isolate()),
+                             backing_store_allocation);
     }
     clone->set_elements(elem);
   }
@@ -2187,7 +2198,8 @@ Handle<JSObject> Factory::CopyJSObjectWithAllocationSite(
     if (properties.length() > 0) {
       // TODO(gsathya): Do not copy hash code.
       Handle<PropertyArray> prop = CopyArrayWithMap(
-          handle(properties, isolate()), handle(properties.map(), isolate()));
+          handle(properties, isolate()), handle(properties.map(), isolate()),
+          backing_store_allocation);
       clone->set_raw_properties_or_hash(*prop, kRelaxedStore);
     }
   } else {
@@ -2224,9 +2236,10 @@ inline void InitEmbedderFields(i::JSObject obj, i::Object initial_value) {
 }  // namespace
 
 template <typename T>
-Handle<T> Factory::CopyArrayWithMap(Handle<T> src, Handle<Map> map) {
+Handle<T> Factory::CopyArrayWithMap(Handle<T> src, Handle<Map> map,
+                                    AllocationType allocation) {
   int len = src->length();
-  HeapObject new_object = AllocateRawFixedArray(len, AllocationType::kYoung);
+  HeapObject new_object = AllocateRawFixedArray(len, allocation);
   DisallowGarbageCollection no_gc;
   new_object.set_map_after_allocation(*map, SKIP_WRITE_BARRIER);
   T result = T::cast(new_object);
@@ -2363,17 +2376,18 @@ Handle<FixedArray> Factory::CopyFixedArrayUpTo(Handle<FixedArray> array,
   return handle(result, isolate());
 }
 
-Handle<FixedArray> Factory::CopyFixedArray(Handle<FixedArray> array) {
+Handle<FixedArray> Factory::CopyFixedArray(Handle<FixedArray> array,
+                                           AllocationType allocation) {
   if (array->length() == 0) return array;
-  return CopyArrayWithMap(array, handle(array->map(), isolate()));
+  return CopyArrayWithMap(array, handle(array->map(), isolate()), allocation);
 }
 
 Handle<FixedDoubleArray> Factory::CopyFixedDoubleArray(
-    Handle<FixedDoubleArray> array) {
+    Handle<FixedDoubleArray> array, AllocationType allocation) {
   int len = array->length();
   if (len == 0) return array;
   Handle<FixedDoubleArray> result =
-      Handle<FixedDoubleArray>::cast(NewFixedDoubleArray(len));
+      Handle<FixedDoubleArray>::cast(NewFixedDoubleArray(len, allocation));
   Heap::CopyBlock(
       result->address() + FixedDoubleArray::kLengthOffset,
       array->address() + FixedDoubleArray::kLengthOffset,
@@ -490,7 +490,8 @@ class V8_EXPORT_PRIVATE Factory : public FactoryBase<Factory> {
   // Properties and elements are copied too.
   Handle<JSObject> CopyJSObject(Handle<JSObject> object);
   // Same as above, but also takes an AllocationSite to be appended in an
-  // AllocationMemento.
+  // AllocationMemento. Backing stores of literals whose site is tenured are
+  // allocated in old space.
   Handle<JSObject> CopyJSObjectWithAllocationSite(Handle<JSObject> object,
                                                   Handle<AllocationSite> site);
 
@@ -522,9 +523,13 @@ class V8_EXPORT_PRIVATE Factory : public FactoryBase<Factory> {
       Handle<FixedArray> array, int new_len,
       AllocationType allocation = AllocationType::kYoung);
 
-  Handle<FixedArray> CopyFixedArray(Handle<FixedArray> array);
+  Handle<FixedArray> CopyFixedArray(
+      Handle<FixedArray> array,
+      AllocationType allocation = AllocationType::kYoung);
 
-  Handle<FixedDoubleArray> CopyFixedDoubleArray(Handle<FixedDoubleArray> array);
+  Handle<FixedDoubleArray> CopyFixedDoubleArray(
+      Handle<FixedDoubleArray> array,
+      AllocationType allocation = AllocationType::kYoung);
 
   // Creates a new HeapNumber in read-only space if possible otherwise old
   // space.
@@ -1128,7 +1133,9 @@ class V8_EXPORT_PRIVATE Factory : public FactoryBase<Factory> {
   HeapObject New(Handle<Map> map, AllocationType allocation);
 
   template <typename T>
-  Handle<T> CopyArrayWithMap(Handle<T> src, Handle<Map> map);
+  Handle<T> CopyArrayWithMap(
+      Handle<T> src, Handle<Map> map,
+      AllocationType allocation = AllocationType::kYoung);
   template <typename T>
   Handle<T> CopyArrayAndGrow(Handle<T> src, int grow_by,
                              AllocationType allocation);
@@ -79,7 +79,7 @@ class FreeListCategory {
   int FreeListLength();
 
   template <typename Callback>
-  void IterateNodesForTesting(Callback callback) {
+  void IterateNodes(Callback callback) {
     for (FreeSpace cur_node = top(); !cur_node.is_null();
          cur_node = cur_node.next()) {
       callback(cur_node);
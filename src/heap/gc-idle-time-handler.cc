@@ -4,6 +4,8 @@
 
 #include "src/heap/gc-idle-time-handler.h"
 
+#include <algorithm>
+
 #include "src/flags/flags.h"
 #include "src/utils/utils.h"
 
@@ -15,6 +17,9 @@ const double GCIdleTimeHandler::kConservativeTimeRatio = 0.9;
 void GCIdleTimeHeapState::Print() {
   PrintF("size_of_objects=%zu ", size_of_objects);
   PrintF("incremental_marking_stopped=%d ", incremental_marking_stopped);
+  PrintF("incremental_marking_complete=%d ", incremental_marking_complete);
+  PrintF("sweeping_in_progress=%d ", sweeping_in_progress);
+  PrintF("pooled_chunks=%zu ", pooled_chunks);
 }
 
 size_t GCIdleTimeHandler::EstimateMarkingStepSize(
@@ -32,21 +37,48 @@ size_t GCIdleTimeHandler::EstimateMarkingStepSize(
   return static_cast<size_t>(marking_step_size * kConservativeTimeRatio);
 }
 
+double GCIdleTimeHandler::EstimateFinalIncrementalMarkCompactTime(
+    size_t size_of_objects, double mark_compact_speed_in_bytes_per_ms) {
+  if (mark_compact_speed_in_bytes_per_ms == 0) {
+    mark_compact_speed_in_bytes_per_ms =
+        kInitialConservativeFinalIncrementalMarkCompactSpeed;
+  }
+  double result = size_of_objects / mark_compact_speed_in_bytes_per_ms;
+  return std::min<double>(result, kMaxFinalIncrementalMarkCompactTimeInMs);
+}
+
 // The following logic is implemented by the controller:
-// (1) If we don't have any idle time, do nothing, unless a context was
-// disposed, incremental marking is stopped, and the heap is small. Then do
-// a full GC.
-// (2) If the context disposal rate is high and we cannot perform a full GC,
-// we do nothing until the context disposal rate becomes lower.
-// (3) If incremental marking is in progress, we perform a marking step.
+// (1) If we don't have any idle time, do nothing.
+// (2) If incremental marking is in progress, we perform a marking step. Once
+// marking is complete, we finalize it if the final pause fits into the idle
+// time.
+// (3) If sweeping is in progress, we sweep pages until the deadline.
+// (4) If the idle period is long, we release pooled pages.
 GCIdleTimeAction GCIdleTimeHandler::Compute(double idle_time_in_ms,
                                             GCIdleTimeHeapState heap_state) {
-  if (static_cast<int>(idle_time_in_ms) <= 0) {
+  if (idle_time_in_ms <= 0) {
     return GCIdleTimeAction::kDone;
   }
 
   if (v8_flags.incremental_marking && !heap_state.incremental_marking_stopped) {
-    return GCIdleTimeAction::kIncrementalStep;
+    if (!heap_state.incremental_marking_complete) {
+      return GCIdleTimeAction::kIncrementalStep;
+    }
+    if (EstimateFinalIncrementalMarkCompactTime(
+            heap_state.size_of_objects,
+            heap_state.final_incremental_mark_compact_speed_in_bytes_per_ms) <=
+        idle_time_in_ms * kConservativeTimeRatio) {
+      return GCIdleTimeAction::kFinalizeIncrementalMarking;
+    }
+  }
+
+  if (heap_state.sweeping_in_progress) {
+    return GCIdleTimeAction::kSweep;
+  }
+
+  if (heap_state.pooled_chunks > 0 &&
+      idle_time_in_ms >= kMinIdleTimeToReleasePooledMemoryInMs) {
+    return GCIdleTimeAction::kReleasePooledMemory;
   }
 
   return GCIdleTimeAction::kDone;
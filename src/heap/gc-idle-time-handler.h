@@ -13,6 +13,9 @@ namespace internal {
 enum class GCIdleTimeAction : uint8_t {
   kDone,
   kIncrementalStep,
+  kFinalizeIncrementalMarking,
+  kSweep,
+  kReleasePooledMemory,
 };
 
 class GCIdleTimeHeapState {
@@ -21,11 +24,17 @@ class GCIdleTimeHeapState {
 
   size_t size_of_objects;
   bool incremental_marking_stopped;
+  bool incremental_marking_complete = false;
+  double final_incremental_mark_compact_speed_in_bytes_per_ms = 0;
+  bool sweeping_in_progress = false;
+  size_t pooled_chunks = 0;
 };
 
 
 // The idle time handler makes decisions about which garbage collection
-// operations are executing during IdleNotification.
+// operations are executing during IdleNotification. IdleNotification keeps
+// asking for the next action until the deadline is reached, so each action is
+// sized to end before it.
 class V8_EXPORT_PRIVATE GCIdleTimeHandler {
  public:
   // If we haven't recorded any incremental marking events yet, we carefully
@@ -35,6 +44,19 @@ class V8_EXPORT_PRIVATE GCIdleTimeHandler {
   // Maximum marking step size returned by EstimateMarkingStepSize.
   static const size_t kMaximumMarkingStepSize = 700 * MB;
 
+  // Conservative lower bound for the speed of the final incremental
+  // mark-compact pause when it hasn't been observed yet.
+  static const size_t kInitialConservativeFinalIncrementalMarkCompactSpeed =
+      2 * MB;
+
+  // Maximum final incremental mark-compact time returned by
+  // EstimateFinalIncrementalMarkCompactTime.
+  static const size_t kMaxFinalIncrementalMarkCompactTimeInMs = 1000;
+
+  // Pooled pages are only released in idle periods of at least this length;
+  // short gaps between tasks don't mean that the pages won't be needed soon.
+  static const size_t kMinIdleTimeToReleasePooledMemoryInMs = 16;
+
   // We have to make sure that we finish the IdleNotification before
   // idle_time_in_ms. Hence, we conservatively prune our workload estimate.
   static const double kConservativeTimeRatio;
@@ -0,0 +1,98 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/heap/gc-pause-controller.h"
+
+#include <algorithm>
+
+#include "src/execution/isolate.h"
+#include "src/flags/flags.h"
+#include "src/heap/gc-tracer.h"
+#include "src/heap/heap.h"
+#include "src/logging/counters.h"
+
+namespace v8 {
+namespace internal {
+
+GCPauseController::GCPauseController(Heap* heap)
+    : heap_(heap), max_pause_ms_(std::max(v8_flags.gc_pause_target_ms, 0.0)) {}
+
+void GCPauseController::SetMaxPause(double max_pause_ms) {
+  max_pause_ms_ = std::max(max_pause_ms, 0.0);
+  young_correction_ = 1.0;
+  full_correction_ = 1.0;
+}
+
+double GCPauseController::PredictYoungPauseInMs(
+    size_t young_object_size) const {
+  GCTracer* tracer = heap_->tracer();
+  const double speed =
+      tracer->ScavengeSpeedInBytesPerMillisecond(kForSurvivedObjects);
+  if (speed == 0) return 0;
+  const double survived_bytes =
+      young_object_size * tracer->AverageSurvivalRatio() / 100;
+  return young_correction_ * survived_bytes / speed;
+}
+
+double GCPauseController::PredictFullPauseInMs(size_t object_size,
+                                               bool incremental) const {
+  GCTracer* tracer = heap_->tracer();
+  const double speed =
+      incremental
+          ? tracer->FinalIncrementalMarkCompactSpeedInBytesPerMillisecond()
+          : tracer->MarkCompactSpeedInBytesPerMillisecond();
+  if (speed == 0) return 0;
+  return full_correction_ * object_size / speed;
+}
+
+double GCPauseController::IncrementalMarkingStepInMs(
+    double default_step_ms) const {
+  if (!IsEnabled()) return default_step_ms;
+  return std::min(default_step_ms, max_pause_ms_);
+}
+
+bool GCPauseController::AllowsNewSpaceCapacity(size_t capacity) const {
+  if (!IsEnabled()) return true;
+  return PredictYoungPauseInMs(capacity) <= max_pause_ms_;
+}
+
+double GCPauseController::CompactionBudgetInMs() const {
+  if (v8_flags.compaction_pause_budget_ms > 0) {
+    return v8_flags.compaction_pause_budget_ms;
+  }
+  if (!IsEnabled()) return 0;
+  // Give up on evacuation first when full GC pauses overshoot the target.
+  return max_pause_ms_ * kCompactionShare / full_correction_;
+}
+
+void GCPauseController::NotifyPause(bool is_young, double predicted_ms,
+                                    double actual_ms) {
+  if (!IsEnabled() || predicted_ms <= 0) return;
+  heap_->isolate()->counters()->gc_pause_prediction_ratio()->AddSample(
+      static_cast<int>(100 * actual_ms / predicted_ms));
+  double& correction = is_young ? young_correction_ : full_correction_;
+  correction = UpdateCorrection(correction, predicted_ms, actual_ms);
+  if (v8_flags.trace_gc_verbose) {
+    heap_->isolate()->PrintWithTimestamp(
+        "[GCPauseController] %s pause: predicted %.1f ms, actual %.1f ms, "
+        "target %.1f ms, correction %.2f\n",
+        is_young ? "young" : "full", predicted_ms, actual_ms, max_pause_ms_,
+        correction);
+  }
+}
+
+// static
+double GCPauseController::UpdateCorrection(double correction,
+                                           double predicted_ms,
+                                           double actual_ms) {
+  DCHECK_LT(0, predicted_ms);
+  // |predicted_ms| already includes |correction|.
+  const double observed = correction * actual_ms / predicted_ms;
+  const double updated =
+      (1 - kCorrectionWeight) * correction + kCorrectionWeight * observed;
+  return std::clamp(updated, kMinCorrection, kMaxCorrection);
+}
+
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,76 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_HEAP_GC_PAUSE_CONTROLLER_H_
+#define V8_HEAP_GC_PAUSE_CONTROLLER_H_
+
+#include <cstddef>
+
+#include "src/common/globals.h"
+#include "testing/gtest/include/gtest/gtest_prod.h"  // nogncheck
+
+namespace v8 {
+namespace internal {
+
+class Heap;
+
+// Keeps individual GC pauses below a target set by the embedder via
+// v8::Isolate::SetGarbageCollectionPauseTarget() or --gc-pause-target-ms.
+//
+// Pause times are predicted from the speeds recorded by the GCTracer and
+// corrected with a moving average of the observed prediction error. The
+// predictions bound incremental marking steps, the young generation capacity
+// and the time spent on evacuation in full GCs. Without a target the default
+// heuristics are used unchanged.
+class V8_EXPORT_PRIVATE GCPauseController final {
+ public:
+  // Weight of the most recent observation in the prediction correction.
+  static constexpr double kCorrectionWeight = 0.3;
+  static constexpr double kMinCorrection = 0.25;
+  static constexpr double kMaxCorrection = 4.0;
+  // Share of the pause target that may be spent on evacuation.
+  static constexpr double kCompactionShare = 0.5;
+
+  explicit GCPauseController(Heap* heap);
+  GCPauseController(const GCPauseController&) = delete;
+  GCPauseController& operator=(const GCPauseController&) = delete;
+
+  // Sets the pause target in milliseconds. 0 disables the controller.
+  void SetMaxPause(double max_pause_ms);
+  double max_pause_ms() const { return max_pause_ms_; }
+  bool IsEnabled() const { return max_pause_ms_ > 0; }
+
+  // Predicted duration of a scavenge of |young_object_size| bytes.
+  double PredictYoungPauseInMs(size_t young_object_size) const;
+  // Predicted duration of the atomic pause of a full GC of |object_size|
+  // bytes.
+  double PredictFullPauseInMs(size_t object_size, bool incremental) const;
+
+  // Time budget for a single incremental marking step.
+  double IncrementalMarkingStepInMs(double default_step_ms) const;
+  // Whether new space may grow to |capacity| without scavenges exceeding the
+  // target.
+  bool AllowsNewSpaceCapacity(size_t capacity) const;
+  // Time budget for evacuation in a full GC. 0 means no limit.
+  double CompactionBudgetInMs() const;
+
+  // Called by the GCTracer after every young or atomic full GC pause.
+  void NotifyPause(bool is_young, double predicted_ms, double actual_ms);
+
+ private:
+  static double UpdateCorrection(double correction, double predicted_ms,
+                                 double actual_ms);
+
+  Heap* const heap_;
+  double max_pause_ms_;
+  double young_correction_ = 1.0;
+  double full_correction_ = 1.0;
+
+  FRIEND_TEST(GCPauseControllerTest, CorrectionFollowsObservedPauses);
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_HEAP_GC_PAUSE_CONTROLLER_H_
@@ -13,6 +13,7 @@
 #include "src/execution/thread-id.h"
 #include "src/heap/cppgc-js/cpp-heap.h"
 #include "src/heap/cppgc/metric-recorder.h"
+#include "src/heap/gc-pause-controller.h"
 #include "src/heap/gc-tracer-inl.h"
 #include "src/heap/heap-inl.h"
 #include "src/heap/heap.h"
@@ -64,7 +65,13 @@ GCTracer::Event::Event(Type type, State state,
       young_object_size(0),
       survived_young_object_size(0),
       incremental_marking_bytes(0),
-      incremental_marking_duration(0.0) {
+      incremental_marking_duration(0.0),
+      scavenger_parallel_busy_time(0.0),
+      scavenger_parallel_idle_time(0.0),
+      scavenger_parallel_tasks(0),
+      compaction_candidate_pages(0),
+      compaction_deferred_pages(0),
+      compaction_candidate_live_bytes(0) {
   for (int i = 0; i < Scope::NUMBER_OF_SCOPES; i++) {
     scopes[i] = 0;
   }
@@ -366,6 +373,15 @@ void GCTracer::UpdateStatistics(GarbageCollector collector) {
   AddAllocation(current_.end_time);
 
   double duration = current_.end_time - current_.start_time;
+  // Predict the pause from the statistics of previous cycles before this
+  // cycle is recorded.
+  GCPauseController* pause_controller = heap_->pause_controller();
+  const double predicted_duration =
+      is_young ? pause_controller->PredictYoungPauseInMs(
+                     current_.young_object_size)
+               : pause_controller->PredictFullPauseInMs(
+                     current_.start_object_size,
+                     current_.type == Event::INCREMENTAL_MARK_COMPACTOR);
   int64_t duration_us =
       static_cast<int64_t>(duration * base::Time::kMicrosecondsPerMillisecond);
   auto* long_task_stats = heap_->isolate()->GetCurrentLongTaskStats();
@@ -394,6 +410,7 @@ void GCTracer::UpdateStatistics(GarbageCollector collector) {
   }
 
   heap_->UpdateTotalGCTime(duration);
+  pause_controller->NotifyPause(is_young, predicted_duration, duration);
 
   if (v8_flags.trace_gc_ignore_scavenger && is_young) return;
 
@@ -674,6 +691,24 @@ void GCTracer::AddSurvivalRatio(double promotion_ratio) {
   recorded_survival_ratios_.Push(promotion_ratio);
 }
 
+void GCTracer::AddScavengerParallelWork(double busy_time, double idle_time,
+                                        int tasks) {
+  DCHECK_EQ(Event::SCAVENGER, current_.type);
+  current_.scavenger_parallel_busy_time += busy_time;
+  current_.scavenger_parallel_idle_time += idle_time;
+  current_.scavenger_parallel_tasks =
+      std::max(current_.scavenger_parallel_tasks, tasks);
+}
+
+void GCTracer::AddCompactionCandidates(int candidate_pages, int deferred_pages,
+                                       size_t live_bytes) {
+  DCHECK(current_.type == Event::MARK_COMPACTOR ||
+         current_.type == Event::INCREMENTAL_MARK_COMPACTOR);
+  current_.compaction_candidate_pages += candidate_pages;
+  current_.compaction_deferred_pages += deferred_pages;
+  current_.compaction_candidate_live_bytes += live_bytes;
+}
+
 void GCTracer::AddIncrementalMarkingStep(double duration, size_t bytes) {
   if (bytes > 0) {
     incremental_marking_bytes_ += bytes;
@@ -790,6 +825,9 @@ void GCTracer::PrintNVP() const {
           "scavenge.weak_global_handles.identify=%.2f "
           "scavenge.weak_global_handles.process=%.2f "
           "scavenge.parallel=%.2f "
+          "scavenge.parallel.busy=%.2f "
+          "scavenge.parallel.idle=%.2f "
+          "scavenge.parallel.tasks=%d "
           "scavenge.update_refs=%.2f "
           "scavenge.sweep_array_buffers=%.2f "
           "background.scavenge.parallel=%.2f "
@@ -831,6 +869,9 @@ void GCTracer::PrintNVP() const {
           current_scope(Scope::SCAVENGER_SCAVENGE_WEAK_GLOBAL_HANDLES_IDENTIFY),
           current_scope(Scope::SCAVENGER_SCAVENGE_WEAK_GLOBAL_HANDLES_PROCESS),
           current_scope(Scope::SCAVENGER_SCAVENGE_PARALLEL),
+          current_.scavenger_parallel_busy_time,
+          current_.scavenger_parallel_idle_time,
+          current_.scavenger_parallel_tasks,
           current_scope(Scope::SCAVENGER_SCAVENGE_UPDATE_REFS),
           current_scope(Scope::SCAVENGER_SWEEP_ARRAY_BUFFERS),
           current_scope(Scope::SCAVENGER_BACKGROUND_SCAVENGE_PARALLEL),
@@ -1042,7 +1083,10 @@ void GCTracer::PrintNVP() const {
           "new_space_survive_rate=%.1f%% "
           "new_space_allocation_throughput=%.1f "
           "unmapper_chunks=%d "
-          "compaction_speed=%.f\n",
+          "compaction_speed=%.f "
+          "compaction.candidates=%d "
+          "compaction.deferred=%d "
+          "compaction.live_bytes=%zu\n",
           duration, spent_in_mutator, current_.TypeName(true),
           current_.reduce_memory, current_scope(Scope::TIME_TO_SAFEPOINT),
           current_scope(Scope::HEAP_PROLOGUE),
@@ -1124,7 +1168,10 @@ void GCTracer::PrintNVP() const {
           heap_->new_space_surviving_rate_,
           NewSpaceAllocationThroughputInBytesPerMillisecond(),
           heap_->memory_allocator()->unmapper()->NumberOfChunks(),
-          CompactionSpeedInBytesPerMillisecond());
+          CompactionSpeedInBytesPerMillisecond(),
+          current_.compaction_candidate_pages,
+          current_.compaction_deferred_pages,
+          current_.compaction_candidate_live_bytes);
       break;
     case Event::START:
       break;
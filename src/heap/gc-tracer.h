@@ -195,6 +195,21 @@ class V8_EXPORT_PRIVATE GCTracer {
     // INCREMENTAL_MARK_COMPACTOR.
     double incremental_marking_duration;
 
+    // Accumulated time (in ms) tasks spent processing work and waiting for the
+    // parallel phase to finish for SCAVENGER.
+    double scavenger_parallel_busy_time;
+    double scavenger_parallel_idle_time;
+
+    // Number of tasks that participated in the parallel phase for SCAVENGER.
+    int scavenger_parallel_tasks;
+
+    // Pages selected as evacuation candidates, pages that qualified for
+    // evacuation but were left for a later cycle, and the live bytes on the
+    // selected candidates for MARK_COMPACTOR and INCREMENTAL_MARK_COMPACTOR.
+    int compaction_candidate_pages;
+    int compaction_deferred_pages;
+    size_t compaction_candidate_live_bytes;
+
     // Amounts of time (in ms) spent in different scopes during GC.
     double scopes[Scope::NUMBER_OF_SCOPES];
 
@@ -299,6 +314,13 @@ class V8_EXPORT_PRIVATE GCTracer {
 
   void AddSurvivalRatio(double survival_ratio);
 
+  // Log the work distribution of the parallel scavenging phase.
+  void AddScavengerParallelWork(double busy_time, double idle_time, int tasks);
+
+  // Log the evacuation candidate selection of a single space.
+  void AddCompactionCandidates(int candidate_pages, int deferred_pages,
+                               size_t live_bytes);
+
   // Log an incremental marking step.
   void AddIncrementalMarkingStep(double duration, size_t bytes);
 
@@ -429,6 +451,8 @@ class V8_EXPORT_PRIVATE GCTracer {
   FRIEND_TEST(GCTracerTest, MutatorUtilization);
   FRIEND_TEST(GCTracerTest, RecordMarkCompactHistograms);
   FRIEND_TEST(GCTracerTest, RecordScavengerHistograms);
+  FRIEND_TEST(GCTracerTest, ScavengerParallelWork);
+  FRIEND_TEST(GCTracerTest, CompactionCandidates);
 
   struct BackgroundCounter {
     double total_duration_ms;
@@ -52,6 +52,7 @@
 #include "src/heap/evacuation-verifier-inl.h"
 #include "src/heap/finalization-registry-cleanup-task.h"
 #include "src/heap/gc-idle-time-handler.h"
+#include "src/heap/gc-pause-controller.h"
 #include "src/heap/gc-tracer-inl.h"
 #include "src/heap/gc-tracer.h"
 #include "src/heap/heap-allocator.h"
@@ -73,6 +74,7 @@
 #include "src/heap/memory-measurement.h"
 #include "src/heap/memory-reducer.h"
 #include "src/heap/new-spaces.h"
+#include "src/heap/object-lifetime-tracker.h"
 #include "src/heap/object-stats.h"
 #include "src/heap/objects-visiting-inl.h"
 #include "src/heap/objects-visiting.h"
@@ -1076,6 +1078,8 @@ void Heap::GarbageCollectionPrologue(
   // with a filler.
   if (new_space()) new_space()->MakeLinearAllocationAreaIterable();
 
+  if (object_lifetime_tracker_) object_lifetime_tracker_->NotifyGCPrologue();
+
   // Reset GC statistics.
   promoted_objects_size_ = 0;
   previous_new_space_surviving_object_size_ = new_space_surviving_object_size_;
@@ -1105,6 +1109,10 @@ void Heap::GarbageCollectionPrologueInSafepoint() {
   TRACE_GC(tracer(), GCTracer::Scope::HEAP_PROLOGUE_SAFEPOINT);
   gc_count_++;
 
+  // Values recorded by the buffered marking barrier need to be marked before
+  // objects move.
+  main_thread_local_heap()->marking_barrier()->FlushBuffer();
+
   DCHECK_EQ(ResizeNewSpaceMode::kNone, resize_new_space_mode_);
   if (new_space_) {
     UpdateNewSpaceAllocationCounter();
@@ -1341,6 +1349,10 @@ void Heap::GarbageCollectionEpilogue(GarbageCollector collector) {
 
   UpdateMaximumCommitted();
 
+  if (object_lifetime_tracker_) {
+    object_lifetime_tracker_->NotifyGCEpilogue(collector);
+  }
+
   if (v8_flags.track_retaining_path &&
       collector == GarbageCollector::MARK_COMPACTOR) {
     retainer_.clear();
@@ -2185,7 +2197,7 @@ size_t Heap::PerformGarbageCollection(GarbageCollector collector,
     DCHECK_EQ(GarbageCollector::MARK_COMPACTOR, collector);
     CompleteSweepingFull();
 
-    memory_allocator()->unmapper()->EnsureUnmappingCompleted();
+    memory_allocator()->unmapper()->EnsureUnmappingCompletedAndTrimPool();
 
     // If incremental marking has been activated, the full GC cycle has already
     // started, so don't start a new one.
@@ -3789,13 +3801,21 @@ Heap::ResizeNewSpaceMode Heap::ShouldResizeNewSpace() {
   static const size_t kLowAllocationThroughput = 1000;
   const double allocation_throughput =
       tracer_->CurrentAllocationThroughputInBytesPerMillisecond();
-  const bool should_shrink = !v8_flags.predictable &&
-                             (allocation_throughput != 0) &&
-                             (allocation_throughput < kLowAllocationThroughput);
+  // Scavenges of the current capacity are predicted to exceed the pause
+  // target.
+  const bool exceeds_pause_target =
+      !pause_controller_->AllowsNewSpaceCapacity(new_space_->TotalCapacity());
+  const bool should_shrink =
+      !v8_flags.predictable &&
+      (((allocation_throughput != 0) &&
+        (allocation_throughput < kLowAllocationThroughput)) ||
+       exceeds_pause_target);
 
   const bool should_grow =
       (new_space_->TotalCapacity() < new_space_->MaximumCapacity()) &&
-      (survived_since_last_expansion_ > new_space_->TotalCapacity());
+      (survived_since_last_expansion_ > new_space_->TotalCapacity()) &&
+      pause_controller_->AllowsNewSpaceCapacity(
+          2 * new_space_->TotalCapacity());
 
   if (should_grow) survived_since_last_expansion_ = 0;
 
@@ -3959,30 +3979,46 @@ GCIdleTimeHeapState Heap::ComputeHeapState() {
   GCIdleTimeHeapState heap_state;
   heap_state.size_of_objects = static_cast<size_t>(SizeOfObjects());
   heap_state.incremental_marking_stopped = incremental_marking()->IsStopped();
+  heap_state.incremental_marking_complete =
+      incremental_marking()->IsMajorMarkingComplete();
+  heap_state.final_incremental_mark_compact_speed_in_bytes_per_ms =
+      tracer()->FinalIncrementalMarkCompactSpeedInBytesPerMillisecond();
+  heap_state.sweeping_in_progress = sweeping_in_progress();
+  heap_state.pooled_chunks =
+      memory_allocator()->unmapper()->NumberOfPooledChunks();
   return heap_state;
 }
 
-bool Heap::PerformIdleTimeAction(GCIdleTimeAction action,
+void Heap::PerformIdleTimeAction(GCIdleTimeAction action,
                                  GCIdleTimeHeapState heap_state,
                                  double deadline_in_ms) {
-  bool result = false;
   switch (action) {
     case GCIdleTimeAction::kDone:
-      result = true;
       break;
-    case GCIdleTimeAction::kIncrementalStep: {
-      incremental_marking()->AdvanceAndFinalizeIfComplete();
-      result = incremental_marking()->IsStopped();
+    case GCIdleTimeAction::kIncrementalStep:
+      if (incremental_marking()->IsMajorMarking()) {
+        incremental_marking()->AdvanceInIdleTime(
+            deadline_in_ms - MonotonicallyIncreasingTimeInMs());
+      }
+      break;
+    case GCIdleTimeAction::kFinalizeIncrementalMarking:
+      FinalizeIncrementalMarkingIfComplete(
+          GarbageCollectionReason::kFinalizeMarkingViaTask);
+      break;
+    case GCIdleTimeAction::kSweep:
+      if (sweeper()->SweepUntilDeadline(deadline_in_ms)) {
+        FinishSweepingIfOutOfWork();
+      }
+      break;
+    case GCIdleTimeAction::kReleasePooledMemory:
+      memory_allocator()->unmapper()->ReleasePooledChunks();
       break;
-    }
   }
-
-  return result;
 }
 
-void Heap::IdleNotificationEpilogue(GCIdleTimeAction action,
-                                    GCIdleTimeHeapState heap_state,
-                                    double start_ms, double deadline_in_ms) {
+void Heap::IdleNotificationEpilogue(
+    base::EnumSet<GCIdleTimeAction> performed_actions,
+    GCIdleTimeHeapState heap_state, double start_ms, double deadline_in_ms) {
   const double idle_time_in_ms = deadline_in_ms - start_ms;
   const double deadline_difference =
       deadline_in_ms - MonotonicallyIncreasingTimeInMs();
@@ -3993,13 +4029,30 @@ void Heap::IdleNotificationEpilogue(GCIdleTimeAction action,
         "ms, deadline usage %.2f ms [",
         idle_time_in_ms, idle_time_in_ms - deadline_difference,
         deadline_difference);
-    switch (action) {
-      case GCIdleTimeAction::kDone:
-        PrintF("done");
-        break;
-      case GCIdleTimeAction::kIncrementalStep:
-        PrintF("incremental step");
-        break;
+    if (performed_actions.empty()) PrintF("done");
+    const char* separator = "";
+    for (GCIdleTimeAction action :
+         {GCIdleTimeAction::kIncrementalStep,
+          GCIdleTimeAction::kFinalizeIncrementalMarking,
+          GCIdleTimeAction::kSweep, GCIdleTimeAction::kReleasePooledMemory}) {
+      if (!performed_actions.contains(action)) continue;
+      switch (action) {
+        case GCIdleTimeAction::kDone:
+          UNREACHABLE();
+        case GCIdleTimeAction::kIncrementalStep:
+          PrintF("%sincremental step", separator);
+          break;
+        case GCIdleTimeAction::kFinalizeIncrementalMarking:
+          PrintF("%sfinalize incremental marking", separator);
+          break;
+        case GCIdleTimeAction::kSweep:
+          PrintF("%ssweep", separator);
+          break;
+        case GCIdleTimeAction::kReleasePooledMemory:
+          PrintF("%srelease pooled memory", separator);
+          break;
+      }
+      separator = ", ";
     }
     PrintF("]");
     if (v8_flags.trace_idle_notification_verbose) {
@@ -4045,12 +4098,24 @@ bool Heap::IdleNotification(double deadline_in_seconds) {
                              OldGenerationAllocationCounter(),
                              EmbedderAllocationCounter());
 
+  // Spend the idle time on chunks of work that each end before the deadline.
+  // Every action runs at most once per notification, as repeating it right
+  // away would not make more progress.
   GCIdleTimeHeapState heap_state = ComputeHeapState();
   GCIdleTimeAction action =
       gc_idle_time_handler_->Compute(idle_time_in_ms, heap_state);
-  bool result = PerformIdleTimeAction(action, heap_state, deadline_in_ms);
-  IdleNotificationEpilogue(action, heap_state, start_ms, deadline_in_ms);
-  return result;
+  base::EnumSet<GCIdleTimeAction> performed_actions;
+  while (action != GCIdleTimeAction::kDone &&
+         !performed_actions.contains(action)) {
+    PerformIdleTimeAction(action, heap_state, deadline_in_ms);
+    performed_actions.Add(action);
+    heap_state = ComputeHeapState();
+    action = gc_idle_time_handler_->Compute(
+        deadline_in_ms - MonotonicallyIncreasingTimeInMs(), heap_state);
+  }
+  IdleNotificationEpilogue(performed_actions, heap_state, start_ms,
+                           deadline_in_ms);
+  return action == GCIdleTimeAction::kDone;
 }
 
 class MemoryPressureInterruptTask : public CancelableTask {
@@ -4084,6 +4149,16 @@ void Heap::CheckMemoryPressure() {
     TRACE_EVENT0("devtools.timeline,v8", "V8.CheckMemoryPressure");
     CollectGarbageOnMemoryPressure();
   } else if (memory_pressure_level == MemoryPressureLevel::kModerate) {
+    if (v8_flags.discard_free_memory_on_memory_pressure) {
+      // Return the free memory of already swept pages right away. Garbage is
+      // only reclaimed by the incremental GC started below.
+      size_t discarded_bytes = sweeper()->ReduceMemoryOnMemoryPressure();
+      if (v8_flags.trace_gc_verbose) {
+        isolate()->PrintWithTimestamp(
+            "Memory pressure: discarded %zu KB of free memory\n",
+            discarded_bytes / KB);
+      }
+    }
     if (v8_flags.incremental_marking && incremental_marking()->IsStopped()) {
       TRACE_EVENT0("devtools.timeline,v8", "V8.CheckMemoryPressure");
       StartIncrementalMarking(kReduceMemoryFootprintMask,
@@ -4882,6 +4957,7 @@ void Heap::IterateStackRoots(RootVisitor* v, StackState stack_state) {
       !disable_conservative_stack_scanning_for_testing_) {
     ConservativeStackVisitor stack_visitor(isolate(), v);
     stack().IteratePointers(&stack_visitor);
+    stack_visitor.VisitCollectedPointers();
   }
 #endif  // V8_ENABLE_CONSERVATIVE_STACK_SCANNING
 }
@@ -5608,6 +5684,7 @@ void Heap::SetUpSpaces(LinearAllocationArea& new_allocation_info,
   }
 
   tracer_.reset(new GCTracer(this));
+  pause_controller_.reset(new GCPauseController(this));
   array_buffer_sweeper_.reset(new ArrayBufferSweeper(this));
   gc_idle_time_handler_.reset(new GCIdleTimeHandler());
   memory_measurement_.reset(new MemoryMeasurement(isolate()));
@@ -5664,6 +5741,11 @@ void Heap::SetUpSpaces(LinearAllocationArea& new_allocation_info,
     stress_scavenge_observer_ = new StressScavengeObserver(this);
     new_space()->AddAllocationObserver(stress_scavenge_observer_);
   }
+  if (v8_flags.track_object_lifetimes && new_space()) {
+    object_lifetime_tracker_.reset(new ObjectLifetimeTracker(
+        this, v8_flags.object_lifetime_sample_interval));
+    new_space()->AddAllocationObserver(object_lifetime_tracker_.get());
+  }
 
   write_protect_code_memory_ = v8_flags.write_protect_code_memory;
 #if V8_HEAP_USE_PKU_JIT_WRITE_PROTECT
@@ -5978,6 +6060,11 @@ void Heap::TearDown() {
     delete stress_scavenge_observer_;
     stress_scavenge_observer_ = nullptr;
   }
+  if (object_lifetime_tracker_) {
+    if (v8_flags.trace_object_lifetimes) object_lifetime_tracker_->Print();
+    new_space()->RemoveAllocationObserver(object_lifetime_tracker_.get());
+    object_lifetime_tracker_.reset();
+  }
 
   if (mark_compact_collector_) {
     mark_compact_collector_->TearDown();
@@ -6017,6 +6104,7 @@ void Heap::TearDown() {
     cpp_heap_ = nullptr;
   }
 
+  pause_controller_.reset();
   tracer_.reset();
 
   pretenuring_handler_.reset();
@@ -98,6 +98,7 @@ class ConcurrentAllocator;
 class ConcurrentMarking;
 class CppHeap;
 class GCIdleTimeHandler;
+class GCPauseController;
 class GCIdleTimeHeapState;
 class GCTracer;
 class IsolateSafepoint;
@@ -116,6 +117,7 @@ class MemoryReducer;
 class MinorMarkCompactCollector;
 class NopRwxMemoryWriteScope;
 class ObjectIterator;
+class ObjectLifetimeTracker;
 class ObjectStats;
 class Page;
 class PagedSpace;
@@ -864,6 +866,12 @@ class Heap {
 
   GCTracer* tracer() { return tracer_.get(); }
 
+  GCPauseController* pause_controller() { return pause_controller_.get(); }
+
+  ObjectLifetimeTracker* object_lifetime_tracker() {
+    return object_lifetime_tracker_.get();
+  }
+
   MemoryAllocator* memory_allocator() { return memory_allocator_.get(); }
   const MemoryAllocator* memory_allocator() const {
     return memory_allocator_.get();
@@ -1874,13 +1882,13 @@ class Heap {
 
   GCIdleTimeHeapState ComputeHeapState();
 
-  bool PerformIdleTimeAction(GCIdleTimeAction action,
+  void PerformIdleTimeAction(GCIdleTimeAction action,
                              GCIdleTimeHeapState heap_state,
                              double deadline_in_ms);
 
-  void IdleNotificationEpilogue(GCIdleTimeAction action,
-                                GCIdleTimeHeapState heap_state, double start_ms,
-                                double deadline_in_ms);
+  void IdleNotificationEpilogue(
+      base::EnumSet<GCIdleTimeAction> performed_actions,
+      GCIdleTimeHeapState heap_state, double start_ms, double deadline_in_ms);
 
   void PrintMaxMarkingLimitReached();
   void PrintMaxNewSpaceSizeReached();
@@ -2294,6 +2302,7 @@ class Heap {
   double last_gc_time_ = 0.0;
 
   std::unique_ptr<GCTracer> tracer_;
+  std::unique_ptr<GCPauseController> pause_controller_;
   std::unique_ptr<Sweeper> sweeper_;
   std::unique_ptr<MarkCompactCollector> mark_compact_collector_;
   std::unique_ptr<MinorMarkCompactCollector> minor_mark_compact_collector_;
@@ -2308,6 +2317,7 @@ class Heap {
   std::unique_ptr<MemoryReducer> memory_reducer_;
   std::unique_ptr<ObjectStats> live_object_stats_;
   std::unique_ptr<ObjectStats> dead_object_stats_;
+  std::unique_ptr<ObjectLifetimeTracker> object_lifetime_tracker_;
   std::unique_ptr<ScavengeJob> scavenge_job_;
   std::unique_ptr<AllocationObserver> scavenge_task_observer_;
   std::unique_ptr<AllocationObserver> minor_mc_task_observer_;
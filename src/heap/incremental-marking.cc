@@ -4,12 +4,15 @@
 
 #include "src/heap/incremental-marking.h"
 
+#include <limits>
+
 #include "src/codegen/compilation-cache.h"
 #include "src/execution/vm-state-inl.h"
 #include "src/handles/global-handles.h"
 #include "src/heap/concurrent-marking.h"
 #include "src/heap/embedder-tracing.h"
 #include "src/heap/gc-idle-time-handler.h"
+#include "src/heap/gc-pause-controller.h"
 #include "src/heap/gc-tracer-inl.h"
 #include "src/heap/gc-tracer.h"
 #include "src/heap/heap-inl.h"
@@ -789,6 +792,11 @@ void IncrementalMarking::AdvanceForTesting(double max_step_size_in_ms) {
   Step(max_step_size_in_ms, StepOrigin::kV8);
 }
 
+void IncrementalMarking::AdvanceInIdleTime(double idle_time_in_ms) {
+  DCHECK(IsMajorMarking());
+  Step(idle_time_in_ms, StepOrigin::kIdleTime);
+}
+
 void IncrementalMarking::AdvanceOnAllocation() {
   DCHECK_EQ(heap_->gc_state(), Heap::NOT_IN_GC);
   DCHECK(v8_flags.incremental_marking);
@@ -801,7 +809,8 @@ void IncrementalMarking::AdvanceOnAllocation() {
   }
 
   ScheduleBytesToMarkBasedOnAllocation();
-  Step(kMaxStepSizeInMs, StepOrigin::kV8);
+  Step(heap_->pause_controller()->IncrementalMarkingStepInMs(kMaxStepSizeInMs),
+       StepOrigin::kV8);
 
   if (IsMajorMarkingComplete()) {
     // Marking cannot be finalized here. Schedule a completion task instead.
@@ -904,6 +913,11 @@ size_t IncrementalMarking::ComputeStepSizeInBytes(StepOrigin step_origin) {
           (bytes_marked_ - scheduled_bytes_to_mark_) / KB);
     }
   }
+  // Idle time is free, so don't hold back when ahead of the schedule. The step
+  // is still bounded by the time it may take.
+  if (step_origin == StepOrigin::kIdleTime) {
+    return std::numeric_limits<size_t>::max();
+  }
   // Allow steps on allocation to get behind the schedule by small amount.
   // This gives higher priority to steps in tasks.
   size_t kScheduleMarginInBytes = step_origin == StepOrigin::kV8 ? 1 * MB : 0;
@@ -923,6 +937,8 @@ void IncrementalMarking::Step(double max_step_size_in_ms,
   DCHECK(IsMajorMarking());
   double start = heap_->MonotonicallyIncreasingTimeInMs();
 
+  heap_->main_thread_local_heap()->marking_barrier()->FlushBuffer();
+
   size_t bytes_to_process = 0;
   size_t v8_bytes_processed = 0;
   double embedder_duration = 0.0;
@@ -991,7 +1007,9 @@ void IncrementalMarking::Step(double max_step_size_in_ms,
         "[IncrementalMarking] Step %s V8: %zuKB (%zuKB), embedder: %fms "
         "(%fms) "
         "in %.1f\n",
-        step_origin == StepOrigin::kV8 ? "in v8" : "in task",
+        step_origin == StepOrigin::kV8         ? "in v8"
+        : step_origin == StepOrigin::kIdleTime ? "in idle time"
+                                               : "in task",
         v8_bytes_processed / KB, bytes_to_process / KB, embedder_duration,
         embedder_deadline, current_time - start);
   }
@@ -33,7 +33,11 @@ enum class StepOrigin {
 
   // The caller of Step() will complete marking by running the GC right
   // afterwards.
-  kTask
+  kTask,
+
+  // The caller of Step() spends idle time and marks as much as fits into it,
+  // even ahead of the schedule. Marking is finalized separately.
+  kIdleTime
 };
 
 enum class CurrentCollector { kNone, kMinorMC, kMajorMC };
@@ -122,6 +126,10 @@ class V8_EXPORT_PRIVATE IncrementalMarking final {
   // marking completes.
   void AdvanceOnAllocation();
 
+  // Performs an incremental marking step that is expected to end within
+  // |idle_time_in_ms|.
+  void AdvanceInIdleTime(double idle_time_in_ms);
+
   // This function is used to color the object black before it undergoes an
   // unsafe layout change. This is a part of synchronization protocol with
   // the concurrent marker.
@@ -4,6 +4,7 @@
 
 #include "src/heap/mark-compact.h"
 
+#include <algorithm>
 #include <memory>
 #include <unordered_map>
 #include <unordered_set>
@@ -29,6 +30,7 @@
 #include "src/heap/concurrent-allocator.h"
 #include "src/heap/evacuation-allocator-inl.h"
 #include "src/heap/evacuation-verifier-inl.h"
+#include "src/heap/gc-pause-controller.h"
 #include "src/heap/gc-tracer-inl.h"
 #include "src/heap/gc-tracer.h"
 #include "src/heap/heap.h"
@@ -717,6 +719,69 @@ void MarkCompactCollector::ComputeEvacuationHeuristics(
     }
     *max_evacuated_bytes = kMaxEvacuatedBytes;
   }
+
+  const double compaction_budget_ms =
+      heap()->pause_controller()->CompactionBudgetInMs();
+  if (compaction_budget_ms > 0) {
+    // Cap the evacuation work of this cycle by the time budget. The budget is
+    // shared by all spaces, so account for candidates that were already
+    // selected in other spaces. Pages that do not fit are left for later
+    // cycles, which pick the most fragmented pages first again.
+    const double estimated_compaction_speed =
+        heap()->tracer()->CompactionSpeedInBytesPerMillisecond();
+    if (estimated_compaction_speed != 0) {
+      size_t selected_bytes = 0;
+      for (Page* p : evacuation_candidates_) {
+        selected_bytes += p->allocated_bytes();
+      }
+      *max_evacuated_bytes = std::min(
+          *max_evacuated_bytes,
+          RemainingEvacuationBudget(estimated_compaction_speed,
+                                    compaction_budget_ms, selected_bytes));
+    }
+  }
+}
+
+// static
+size_t MarkCompactCollector::RemainingEvacuationBudget(double compaction_speed,
+                                                       double budget_ms,
+                                                       size_t selected_bytes) {
+  const size_t budget_bytes =
+      static_cast<size_t>(compaction_speed * budget_ms);
+  return budget_bytes > selected_bytes ? budget_bytes - selected_bytes : 0;
+}
+
+// static
+int MarkCompactCollector::ComputeEvacuationCandidateCount(
+    const std::vector<LiveBytesPagePair>& pages, size_t area_size,
+    size_t max_evacuated_bytes, size_t* total_live_bytes) {
+  int candidate_count = 0;
+  *total_live_bytes = 0;
+  // Select the first n pages for evacuation such that the total size of
+  // evacuated objects does not exceed the specified limit. Pages are sorted,
+  // so once a page does not fit, none of the following ones does.
+  for (const LiveBytesPagePair& page : pages) {
+    const size_t live_bytes = page.first;
+    DCHECK_GE(area_size, live_bytes);
+    if (!v8_flags.compact_on_every_full_gc &&
+        (*total_live_bytes + live_bytes) > max_evacuated_bytes) {
+      break;
+    }
+    candidate_count++;
+    *total_live_bytes += live_bytes;
+  }
+  // How many pages we will allocated for the evacuated objects
+  // in the worst case: ceil(total_live_bytes / area_size)
+  int estimated_new_pages =
+      static_cast<int>((*total_live_bytes + area_size - 1) / area_size);
+  DCHECK_LE(estimated_new_pages, candidate_count);
+  int estimated_released_pages = candidate_count - estimated_new_pages;
+  // Avoid (compact -> expand) cycles.
+  if ((estimated_released_pages == 0) && !v8_flags.compact_on_every_full_gc) {
+    candidate_count = 0;
+    *total_live_bytes = 0;
+  }
+  return candidate_count;
 }
 
 void MarkCompactCollector::CollectEvacuationCandidates(PagedSpace* space) {
@@ -747,8 +812,6 @@ void MarkCompactCollector::CollectEvacuationCandidates(PagedSpace* space) {
     free_bytes_threshold = target_fragmentation_percent * (area_size / 100);
   }
 
-  // Pairs of (live_bytes_in_page, page).
-  using LiveBytesPagePair = std::pair<size_t, Page*>;
   std::vector<LiveBytesPagePair> pages;
   pages.reserve(number_of_pages);
 
@@ -836,15 +899,15 @@ void MarkCompactCollector::CollectEvacuationCandidates(PagedSpace* space) {
               [](const LiveBytesPagePair& a, const LiveBytesPagePair& b) {
                 return a.first < b.first;
               });
-    for (size_t i = 0; i < pages.size(); i++) {
-      size_t live_bytes = pages[i].first;
-      DCHECK_GE(area_size, live_bytes);
-      if (v8_flags.compact_on_every_full_gc ||
-          ((total_live_bytes + live_bytes) <= max_evacuated_bytes)) {
-        candidate_count++;
-        total_live_bytes += live_bytes;
-      }
-      if (v8_flags.trace_fragmentation_verbose) {
+    candidate_count = ComputeEvacuationCandidateCount(
+        pages, area_size, max_evacuated_bytes, &total_live_bytes);
+    if (v8_flags.trace_fragmentation_verbose) {
+      size_t sum_compaction_bytes = 0;
+      for (size_t i = 0; i < pages.size(); i++) {
+        size_t live_bytes = pages[i].first;
+        if (static_cast<int>(i) < candidate_count) {
+          sum_compaction_bytes += live_bytes;
+        }
         PrintIsolate(isolate(),
                      "compaction-selection-page: space=%s free_bytes_page=%zu "
                      "fragmentation_limit_kb=%zu "
@@ -852,22 +915,15 @@ void MarkCompactCollector::CollectEvacuationCandidates(PagedSpace* space) {
                      "compaction_limit_kb=%zu\n",
                      space->name(), (area_size - live_bytes) / KB,
                      free_bytes_threshold / KB, target_fragmentation_percent,
-                     total_live_bytes / KB, max_evacuated_bytes / KB);
+                     sum_compaction_bytes / KB, max_evacuated_bytes / KB);
       }
     }
-    // How many pages we will allocated for the evacuated objects
-    // in the worst case: ceil(total_live_bytes / area_size)
-    int estimated_new_pages =
-        static_cast<int>((total_live_bytes + area_size - 1) / area_size);
-    DCHECK_LE(estimated_new_pages, candidate_count);
-    int estimated_released_pages = candidate_count - estimated_new_pages;
-    // Avoid (compact -> expand) cycles.
-    if ((estimated_released_pages == 0) && !v8_flags.compact_on_every_full_gc) {
-      candidate_count = 0;
-    }
     for (int i = 0; i < candidate_count; i++) {
       AddEvacuationCandidate(pages[i].second);
     }
+    heap()->tracer()->AddCompactionCandidates(
+        candidate_count, static_cast<int>(pages.size()) - candidate_count,
+        total_live_bytes);
   }
 
   if (v8_flags.trace_fragmentation) {
@@ -1264,9 +1320,9 @@ class MarkCompactCollector::ClientCustomRootBodyMarkingVisitor final
 class MarkCompactCollector::SharedHeapObjectVisitor final
     : public ObjectVisitorWithCageBases {
  public:
-  explicit SharedHeapObjectVisitor(MarkCompactCollector* collector)
-      : ObjectVisitorWithCageBases(collector->isolate()),
-        collector_(collector) {}
+  SharedHeapObjectVisitor(Isolate* client,
+                          std::vector<HeapObject>* shared_objects)
+      : ObjectVisitorWithCageBases(client), shared_objects_(shared_objects) {}
 
   void VisitPointer(HeapObject host, ObjectSlot p) final {
     CheckForSharedObject(host, p, p.load(cage_base()));
@@ -1323,10 +1379,41 @@ class MarkCompactCollector::SharedHeapObjectVisitor final
     DCHECK(host_chunk->InYoungGeneration());
     RememberedSet<OLD_TO_SHARED>::Insert<AccessMode::NON_ATOMIC>(
         host_chunk, slot.address());
-    collector_->MarkRootObject(Root::kClientHeap, heap_object);
+    shared_objects_->push_back(heap_object);
   }
 
-  MarkCompactCollector* const collector_;
+  std::vector<HeapObject>* const shared_objects_;
+};
+
+// Scans client heaps for references into the shared heap while all clients are
+// stopped in a global safepoint. Each client is scanned by a single thread;
+// client heaps don't share chunks or remembered sets.
+class MarkCompactCollector::ClientHeapScanningJob final : public v8::JobTask {
+ public:
+  ClientHeapScanningJob(const std::vector<Isolate*>* clients,
+                        std::vector<std::vector<HeapObject>>* shared_objects)
+      : clients_(clients), shared_objects_(shared_objects) {
+    DCHECK_EQ(clients_->size(), shared_objects_->size());
+  }
+
+  void Run(JobDelegate* delegate) override {
+    while (!delegate->ShouldYield()) {
+      const size_t index = next_client_.fetch_add(1, std::memory_order_relaxed);
+      if (index >= clients_->size()) return;
+      CollectSharedObjectsFromClientHeap((*clients_)[index],
+                                         &(*shared_objects_)[index]);
+    }
+  }
+
+  size_t GetMaxConcurrency(size_t worker_count) const override {
+    const size_t next = next_client_.load(std::memory_order_relaxed);
+    return next < clients_->size() ? clients_->size() - next : 0;
+  }
+
+ private:
+  const std::vector<Isolate*>* const clients_;
+  std::vector<std::vector<HeapObject>>* const shared_objects_;
+  std::atomic<size_t> next_client_{0};
 };
 
 class InternalizedStringTableCleaner final : public RootVisitor {
@@ -2255,6 +2342,63 @@ Address MarkCompactCollector::FindBasePtrForMarking(Address maybe_inner_ptr) {
     DCHECK_LT(base_ptr, page->area_end());
   }
 }
+
+void MarkCompactCollector::FindBasePtrsForMarking(
+    const std::vector<Address>& maybe_inner_ptrs,
+    std::vector<Address>* base_ptrs) {
+  DCHECK(std::is_sorted(maybe_inner_ptrs.begin(), maybe_inner_ptrs.end()));
+  PtrComprCageBase cage_base{isolate()};
+  const MemoryChunk* chunk = nullptr;
+  // The object found last on `chunk`, if any. Objects are found in ascending
+  // order, so the forward walk for the next pointer can resume at
+  // `object_end` instead of restarting from the mark bitmap.
+  Address object_start = kNullAddress;
+  Address object_end = kNullAddress;
+  auto add_base_ptr = [base_ptrs](Address base_ptr) {
+    if (base_ptrs->empty() || base_ptrs->back() != base_ptr) {
+      base_ptrs->push_back(base_ptr);
+    }
+  };
+  for (Address maybe_inner_ptr : maybe_inner_ptrs) {
+    if (chunk == nullptr || !chunk->Contains(maybe_inner_ptr)) {
+      chunk = heap()->memory_allocator()->LookupChunkContainingAddress(
+          maybe_inner_ptr);
+      object_start = object_end = kNullAddress;
+      if (chunk == nullptr) continue;
+    }
+    DCHECK(chunk->Contains(maybe_inner_ptr));
+    if (chunk->IsLargePage()) {
+      HeapObject obj(static_cast<const LargePage*>(chunk)->GetObject());
+      if (!obj.IsFreeSpaceOrFiller(cage_base)) add_base_ptr(obj.address());
+      continue;
+    }
+    const Page* page = static_cast<const Page*>(chunk);
+    if (page->IsFromPage()) continue;
+    // Pointers into the object found last resolve to the same object. The
+    // markbit check below only filters objects that were already marked, for
+    // which revisiting is harmless.
+    if (maybe_inner_ptr < object_end) continue;
+    Address base_ptr =
+        FindPreviousObjectForConservativeMarking(page, maybe_inner_ptr);
+    if (base_ptr == kNullAddress) continue;
+    // Both candidates are valid object starts not above `maybe_inner_ptr`.
+    base_ptr = std::max(base_ptr, object_end);
+    DCHECK_LE(base_ptr, maybe_inner_ptr);
+    while (true) {
+      HeapObject obj(HeapObject::FromAddress(base_ptr));
+      const int size = obj.Size(cage_base);
+      DCHECK_LT(0, size);
+      if (maybe_inner_ptr < base_ptr + size) {
+        object_start = base_ptr;
+        object_end = base_ptr + size;
+        if (!obj.IsFreeSpaceOrFiller(cage_base)) add_base_ptr(object_start);
+        break;
+      }
+      base_ptr += size;
+      DCHECK_LT(base_ptr, page->area_end());
+    }
+  }
+}
 #endif  // V8_ENABLE_INNER_POINTER_RESOLUTION_MB
 
 void MarkCompactCollector::MarkRootsFromStack(RootVisitor* root_visitor) {
@@ -2265,27 +2409,51 @@ void MarkCompactCollector::MarkRootsFromStack(RootVisitor* root_visitor) {
 void MarkCompactCollector::MarkObjectsFromClientHeaps() {
   if (!isolate()->is_shared_heap_isolate()) return;
 
+  std::vector<Isolate*> clients;
   isolate()->global_safepoint()->IterateClientIsolates(
-      [collector = this](Isolate* client) {
+      [&clients](Isolate* client) {
         if (client->is_shared_heap_isolate()) return;
-        collector->MarkObjectsFromClientHeap(client);
+        // Ensure new space is iterable.
+        client->heap()->MakeHeapIterable();
+        clients.push_back(client);
       });
+
+  // With many clients, scanning their young generations dominates the pause in
+  // which all of them are stopped, so scan them in parallel.
+  std::vector<std::vector<HeapObject>> shared_objects(clients.size());
+  if (v8_flags.parallel_marking && clients.size() > 1) {
+    V8::GetCurrentPlatform()
+        ->PostJob(TaskPriority::kUserBlocking,
+                  std::make_unique<ClientHeapScanningJob>(&clients,
+                                                          &shared_objects))
+        ->Join();
+  } else {
+    for (size_t i = 0; i < clients.size(); i++) {
+      CollectSharedObjectsFromClientHeap(clients[i], &shared_objects[i]);
+    }
+  }
+
+  for (size_t i = 0; i < clients.size(); i++) {
+    for (HeapObject heap_object : shared_objects[i]) {
+      MarkRootObject(Root::kClientHeap, heap_object);
+    }
+    MarkExternalPointersFromClientHeap(clients[i]);
+  }
 }
 
-void MarkCompactCollector::MarkObjectsFromClientHeap(Isolate* client) {
+// static
+void MarkCompactCollector::CollectSharedObjectsFromClientHeap(
+    Isolate* client, std::vector<HeapObject>* shared_objects) {
   // There is no OLD_TO_SHARED remembered set for the young generation. We
   // therefore need to iterate each object and check whether it points into the
   // shared heap. As an optimization and to avoid a second heap iteration in the
   // "update pointers" phase, all pointers into the shared heap are recorded in
   // the OLD_TO_SHARED remembered set as well.
-  SharedHeapObjectVisitor visitor(this);
+  SharedHeapObjectVisitor visitor(client, shared_objects);
 
   PtrComprCageBase cage_base(client);
   Heap* heap = client->heap();
 
-  // Ensure new space is iterable.
-  heap->MakeHeapIterable();
-
   if (heap->new_space()) {
     std::unique_ptr<ObjectIterator> iterator =
         heap->new_space()->GetObjectIterator(heap);
@@ -2317,14 +2485,14 @@ void MarkCompactCollector::MarkObjectsFromClientHeap(Isolate* client) {
         chunk, InvalidatedSlotsFilter::LivenessCheck::kNo);
     RememberedSet<OLD_TO_SHARED>::Iterate(
         chunk,
-        [collector = this, cage_base, &filter](MaybeObjectSlot slot) {
+        [shared_objects, cage_base, &filter](MaybeObjectSlot slot) {
           if (!filter.IsValid(slot.address())) return REMOVE_SLOT;
           MaybeObject obj = slot.Relaxed_Load(cage_base);
           HeapObject heap_object;
 
           if (obj.GetHeapObject(&heap_object) &&
               heap_object.InSharedWritableHeap()) {
-            collector->MarkRootObject(Root::kClientHeap, heap_object);
+            shared_objects->push_back(heap_object);
             return KEEP_SLOT;
           } else {
             return REMOVE_SLOT;
@@ -2334,18 +2502,20 @@ void MarkCompactCollector::MarkObjectsFromClientHeap(Isolate* client) {
     chunk->ReleaseInvalidatedSlots<OLD_TO_SHARED>();
 
     RememberedSet<OLD_TO_SHARED>::IterateTyped(
-        chunk, [collector = this, heap](SlotType slot_type, Address slot) {
+        chunk, [shared_objects, heap](SlotType slot_type, Address slot) {
           HeapObject heap_object =
               UpdateTypedSlotHelper::GetTargetObject(heap, slot_type, slot);
           if (heap_object.InSharedWritableHeap()) {
-            collector->MarkRootObject(Root::kClientHeap, heap_object);
+            shared_objects->push_back(heap_object);
             return KEEP_SLOT;
           } else {
             return REMOVE_SLOT;
           }
         });
   }
+}
 
+void MarkCompactCollector::MarkExternalPointersFromClientHeap(Isolate* client) {
 #ifdef V8_COMPRESS_POINTERS
   DCHECK(IsSharedExternalPointerType(kWaiterQueueNodeTag));
   // Custom marking for the external pointer table entry used to hold
@@ -2368,7 +2538,7 @@ void MarkCompactCollector::MarkObjectsFromClientHeap(Isolate* client) {
   // table. Mark entries from client heaps.
   MarkExternalPointerFromExternalStringTable external_string_visitor(
       &shared_table);
-  heap->external_string_table_.IterateAll(&external_string_visitor);
+  client->heap()->external_string_table_.IterateAll(&external_string_visitor);
 #endif  // V8_ENABLE_SANDBOX
 }
 
@@ -2461,7 +2631,9 @@ void MarkCompactCollector::MarkTransitiveClosureLinear() {
            GCTracer::Scope::MC_MARK_WEAK_CLOSURE_EPHEMERON_LINEAR);
   // This phase doesn't support parallel marking.
   DCHECK(heap()->concurrent_marking()->IsStopped());
-  std::unordered_multimap<HeapObject, HeapObject, Object::Hasher> key_to_values;
+  EphemeronMarking::KeyToValues& key_to_values =
+      ephemeron_marking_.key_to_values;
+  DCHECK(key_to_values.empty());
   Ephemeron ephemeron;
 
   DCHECK(
@@ -2475,22 +2647,19 @@ void MarkCompactCollector::MarkTransitiveClosureLinear() {
     }
   }
 
-  ephemeron_marking_.newly_discovered_limit = key_to_values.size();
   bool work_to_do = true;
 
   while (work_to_do) {
     PerformWrapperTracing();
 
-    ResetNewlyDiscovered();
-    ephemeron_marking_.newly_discovered_limit = key_to_values.size();
-
     {
       TRACE_GC(heap()->tracer(),
                GCTracer::Scope::MC_MARK_WEAK_CLOSURE_EPHEMERON_MARKING);
-      // Drain marking worklist and push all discovered objects into
-      // newly_discovered.
-      ProcessMarkingWorklist(
-          0, MarkingWorklistProcessingMode::kTrackNewlyDiscoveredObjects);
+      // Drain marking worklist. Every processed object is looked up in
+      // key_to_values, so values become reachable as soon as their key is
+      // marked, without rescanning the remaining ephemerons.
+      ProcessMarkingWorklist(0, MarkingWorklistProcessingMode::
+                                    kMarkEphemeronValuesOfDiscoveredKeys);
     }
 
     while (local_weak_objects()->discovered_ephemerons_local.Pop(&ephemeron)) {
@@ -2501,30 +2670,6 @@ void MarkCompactCollector::MarkTransitiveClosureLinear() {
       }
     }
 
-    if (ephemeron_marking_.newly_discovered_overflowed) {
-      // If newly_discovered was overflowed just visit all ephemerons in
-      // next_ephemerons.
-      local_weak_objects()->next_ephemerons_local.Publish();
-      weak_objects_.next_ephemerons.Iterate([&](Ephemeron ephemeron) {
-        if (non_atomic_marking_state()->IsBlackOrGrey(ephemeron.key) &&
-            non_atomic_marking_state()->WhiteToGrey(ephemeron.value)) {
-          local_marking_worklists()->Push(ephemeron.value);
-        }
-      });
-
-    } else {
-      // This is the good case: newly_discovered stores all discovered
-      // objects. Now use key_to_values to see if discovered objects keep more
-      // objects alive due to ephemeron semantics.
-      for (HeapObject object : ephemeron_marking_.newly_discovered) {
-        auto range = key_to_values.equal_range(object);
-        for (auto it = range.first; it != range.second; ++it) {
-          HeapObject value = it->second;
-          MarkObject(object, value);
-        }
-      }
-    }
-
     // Do NOT drain marking worklist here, otherwise the current checks
     // for work_to_do are not sufficient for determining if another iteration
     // is necessary.
@@ -2536,8 +2681,8 @@ void MarkCompactCollector::MarkTransitiveClosureLinear() {
               ->discovered_ephemerons_local.IsLocalAndGlobalEmpty());
   }
 
-  ResetNewlyDiscovered();
-  ephemeron_marking_.newly_discovered.shrink_to_fit();
+  // Release the index including its buckets.
+  EphemeronMarking::KeyToValues().swap(key_to_values);
 
   CHECK(local_marking_worklists()->IsEmpty());
 
@@ -2549,6 +2694,15 @@ void MarkCompactCollector::MarkTransitiveClosureLinear() {
   local_weak_objects()->next_ephemerons_local.Publish();
 }
 
+void MarkCompactCollector::MarkEphemeronValuesOf(HeapObject key) {
+  auto range = ephemeron_marking_.key_to_values.equal_range(key);
+  if (range.first == range.second) return;
+  for (auto it = range.first; it != range.second; ++it) {
+    MarkObject(key, it->second);
+  }
+  ephemeron_marking_.key_to_values.erase(range.first, range.second);
+}
+
 void MarkCompactCollector::PerformWrapperTracing() {
   if (heap_->local_embedder_heap_tracer()->InUse()) {
     TRACE_GC(heap()->tracer(), GCTracer::Scope::MC_MARK_EMBEDDER_TRACING);
@@ -2609,8 +2763,8 @@ std::pair<size_t, size_t> MarkCompactCollector::ProcessMarkingWorklist(
     DCHECK(heap()->Contains(object));
     DCHECK(!(marking_state()->IsWhite(object)));
     if (mode == MarkCompactCollector::MarkingWorklistProcessingMode::
-                    kTrackNewlyDiscoveredObjects) {
-      AddNewlyDiscovered(object);
+                    kMarkEphemeronValuesOfDiscoveredKeys) {
+      MarkEphemeronValuesOf(object);
     }
     Map map = object.map(cage_base);
     if (is_per_context_mode) {
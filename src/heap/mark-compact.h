@@ -323,6 +323,7 @@ class MarkCompactCollector final : public CollectorBase {
   class CustomRootBodyMarkingVisitor;
   class ClientCustomRootBodyMarkingVisitor;
   class SharedHeapObjectVisitor;
+  class ClientHeapScanningJob;
   class RootMarkingVisitor;
 
   enum class StartCompactionMode {
@@ -332,7 +333,7 @@ class MarkCompactCollector final : public CollectorBase {
 
   enum class MarkingWorklistProcessingMode {
     kDefault,
-    kTrackNewlyDiscoveredObjects
+    kMarkEphemeronValuesOfDiscoveredKeys
   };
 
   static MarkCompactCollector* From(CollectorBase* collector) {
@@ -360,6 +361,25 @@ class MarkCompactCollector final : public CollectorBase {
 
   void AddEvacuationCandidate(Page* p);
 
+  // Pairs of (live_bytes_in_page, page).
+  using LiveBytesPagePair = std::pair<size_t, Page*>;
+
+  // Returns how many pages from the front of |pages|, which qualify for
+  // evacuation and are sorted by live bytes, are evacuated in this cycle
+  // without exceeding |max_evacuated_bytes|. The remaining pages are left for
+  // later cycles. Stores the live bytes of the selected pages in
+  // |total_live_bytes|.
+  static V8_EXPORT_PRIVATE int ComputeEvacuationCandidateCount(
+      const std::vector<LiveBytesPagePair>& pages, size_t area_size,
+      size_t max_evacuated_bytes, size_t* total_live_bytes);
+
+  // Returns how many bytes may still be evacuated in this cycle when
+  // compacting at |compaction_speed| bytes/ms for at most |budget_ms|, given
+  // that |selected_bytes| were already selected in other spaces.
+  static V8_EXPORT_PRIVATE size_t
+  RemainingEvacuationBudget(double compaction_speed, double budget_ms,
+                            size_t selected_bytes);
+
   // Prepares for GC by resetting relocation info in old and map spaces and
   // choosing spaces to compact.
   void Prepare() final;
@@ -433,21 +453,9 @@ class MarkCompactCollector final : public CollectorBase {
 
   void VisitObject(HeapObject obj) final;
 
-  void AddNewlyDiscovered(HeapObject object) {
-    if (ephemeron_marking_.newly_discovered_overflowed) return;
-
-    if (ephemeron_marking_.newly_discovered.size() <
-        ephemeron_marking_.newly_discovered_limit) {
-      ephemeron_marking_.newly_discovered.push_back(object);
-    } else {
-      ephemeron_marking_.newly_discovered_overflowed = true;
-    }
-  }
-
-  void ResetNewlyDiscovered() {
-    ephemeron_marking_.newly_discovered_overflowed = false;
-    ephemeron_marking_.newly_discovered.clear();
-  }
+  // Marks the values of all indexed ephemerons with the given key and removes
+  // them from the index.
+  void MarkEphemeronValuesOf(HeapObject key);
 
   explicit MarkCompactCollector(Heap* heap);
   ~MarkCompactCollector() final;
@@ -464,6 +472,13 @@ class MarkCompactCollector final : public CollectorBase {
   // heap object, or if it points to (the interior of) some object that is
   // already marked as live (black or grey).
   V8_EXPORT_PRIVATE Address FindBasePtrForMarking(Address maybe_inner_ptr);
+  // Same as FindBasePtrForMarking() for a sorted vector of pointers without
+  // duplicates. Pages are looked up once per run of pointers into them and
+  // each page is walked at most once. The resulting object headers are
+  // appended to `base_ptrs` in ascending order without duplicates.
+  V8_EXPORT_PRIVATE void FindBasePtrsForMarking(
+      const std::vector<Address>& maybe_inner_ptrs,
+      std::vector<Address>* base_ptrs);
 #endif  // V8_ENABLE_INNER_POINTER_RESOLUTION_MB
 
  private:
@@ -500,7 +515,11 @@ class MarkCompactCollector final : public CollectorBase {
   // Mark all objects that are directly referenced from one of the clients
   // heaps.
   void MarkObjectsFromClientHeaps();
-  void MarkObjectsFromClientHeap(Isolate* client);
+  // Collects the shared objects referenced from the heap of |client|. Different
+  // clients can be scanned in parallel.
+  static void CollectSharedObjectsFromClientHeap(
+      Isolate* client, std::vector<HeapObject>* shared_objects);
+  void MarkExternalPointersFromClientHeap(Isolate* client);
 
   // Updates pointers to shared objects from client heaps.
   void UpdatePointersInClientHeaps();
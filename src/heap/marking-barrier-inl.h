@@ -69,6 +69,24 @@ void MarkingBarrier::MarkValueShared(HeapObject value) {
 }
 
 void MarkingBarrier::MarkValueLocal(HeapObject value) {
+  if (V8_UNLIKELY(is_buffered_)) {
+    BufferValue(value);
+    return;
+  }
+  MarkValueLocalUnbuffered(value);
+}
+
+void MarkingBarrier::BufferValue(HeapObject value) {
+  DCHECK(is_main_thread_barrier_);
+  const size_t index =
+      (value.address() >> kObjectAlignmentBits) % kRecentValuesSize;
+  if (recent_values_[index] == value.address()) return;
+  recent_values_[index] = value.address();
+  buffer_[buffer_size_++] = value;
+  if (buffer_size_ == kBufferSize) FlushBuffer();
+}
+
+void MarkingBarrier::MarkValueLocalUnbuffered(HeapObject value) {
   if (is_minor()) {
     // We do not need to insert into RememberedSet<OLD_TO_NEW> here because the
     // C++ marking barrier already does this for us.
@@ -32,10 +32,24 @@ MarkingBarrier::MarkingBarrier(LocalHeap* local_heap)
       marking_state_(isolate()),
       is_main_thread_barrier_(local_heap->is_main_thread()),
       uses_shared_heap_(isolate()->has_shared_heap()),
-      is_shared_space_isolate_(isolate()->is_shared_space_isolate()) {}
+      is_shared_space_isolate_(isolate()->is_shared_space_isolate()),
+      is_buffered_(v8_flags.buffered_marking_barrier &&
+                   local_heap->is_main_thread()) {}
 
 MarkingBarrier::~MarkingBarrier() { DCHECK(typed_slots_map_.empty()); }
 
+void MarkingBarrier::FlushBuffer() {
+  if (buffer_size_ == 0) return;
+  DCHECK(is_activated_);
+  for (size_t i = 0; i < buffer_size_; i++) {
+    MarkValueLocalUnbuffered(buffer_[i]);
+  }
+  buffer_size_ = 0;
+  // Addresses may be reused for new objects after the next GC, so values are
+  // only filtered until the next flush.
+  recent_values_.fill(kNullAddress);
+}
+
 void MarkingBarrier::Write(HeapObject host, HeapObjectSlot slot,
                            HeapObject value) {
   DCHECK(IsCurrentMarkingBarrier(host));
@@ -331,6 +345,9 @@ void MarkingBarrier::DeactivateAll(Heap* heap) {
 }
 
 void MarkingBarrier::Deactivate() {
+  // Values that were not flushed by a GC are not needed anymore.
+  buffer_size_ = 0;
+  recent_values_.fill(kNullAddress);
   is_activated_ = false;
   is_compacting_ = false;
   DCHECK(typed_slots_map_.empty());
@@ -364,6 +381,7 @@ void MarkingBarrier::PublishAll(Heap* heap) {
 
 void MarkingBarrier::PublishIfNeeded() {
   if (is_activated_) {
+    FlushBuffer();
     current_worklist_->Publish();
     base::Optional<CodePageHeaderModificationScope> optional_rwx_write_scope;
     if (!typed_slots_map_.empty()) {
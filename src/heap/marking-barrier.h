@@ -5,6 +5,8 @@
 #ifndef V8_HEAP_MARKING_BARRIER_H_
 #define V8_HEAP_MARKING_BARRIER_H_
 
+#include <array>
+
 #include "include/v8-internal.h"
 #include "src/common/globals.h"
 #include "src/heap/mark-compact.h"
@@ -49,6 +51,10 @@ class MarkingBarrier {
 
   inline void MarkValue(HeapObject host, HeapObject value);
 
+  // Marks the values recorded by the buffered barrier. Needs to be called
+  // before objects are moved and whenever marking should see the values.
+  void FlushBuffer();
+
   bool is_minor() const {
     return marking_barrier_type_ == MarkingBarrierType::kMinor;
   }
@@ -63,6 +69,8 @@ class MarkingBarrier {
  private:
   inline void MarkValueShared(HeapObject value);
   inline void MarkValueLocal(HeapObject value);
+  inline void MarkValueLocalUnbuffered(HeapObject value);
+  inline void BufferValue(HeapObject value);
 
   inline bool WhiteToGreyAndPush(HeapObject value);
 
@@ -97,6 +105,16 @@ class MarkingBarrier {
   const bool uses_shared_heap_;
   const bool is_shared_space_isolate_;
   MarkingBarrierType marking_barrier_type_;
+
+  // With --buffered-marking-barrier the main thread barrier records local
+  // values in a small buffer and marks them in batches. Repeated writes of a
+  // recently recorded value are filtered.
+  static constexpr size_t kBufferSize = 64;
+  static constexpr size_t kRecentValuesSize = 16;
+  const bool is_buffered_;
+  size_t buffer_size_ = 0;
+  std::array<HeapObject, kBufferSize> buffer_;
+  std::array<Address, kRecentValuesSize> recent_values_{};
 };
 
 }  // namespace internal
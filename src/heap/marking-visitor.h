@@ -5,6 +5,8 @@
 #ifndef V8_HEAP_MARKING_VISITOR_H_
 #define V8_HEAP_MARKING_VISITOR_H_
 
+#include <unordered_map>
+
 #include "src/common/globals.h"
 #include "src/heap/marking-state.h"
 #include "src/heap/marking-worklist.h"
@@ -16,9 +18,12 @@ namespace v8 {
 namespace internal {
 
 struct EphemeronMarking {
-  std::vector<HeapObject> newly_discovered;
-  bool newly_discovered_overflowed;
-  size_t newly_discovered_limit;
+  using KeyToValues =
+      std::unordered_multimap<HeapObject, HeapObject, Object::Hasher>;
+  // Values of ephemerons with unmarked keys and values, indexed by key. Used by
+  // the linear ephemeron algorithm to mark values in O(1) once their key gets
+  // marked.
+  KeyToValues key_to_values;
 };
 
 // The base class for all marking visitors. It implements marking logic with
@@ -142,6 +142,30 @@ void MemoryAllocator::Unmapper::EnsureUnmappingCompleted() {
   PerformFreeMemoryOnQueuedChunks(FreeMode::kFreePooled);
 }
 
+void MemoryAllocator::Unmapper::EnsureUnmappingCompletedAndTrimPool() {
+  CancelAndWaitForPendingTasks();
+  PerformFreeMemoryOnQueuedChunks(FreeMode::kTrimPooled);
+}
+
+void MemoryAllocator::Unmapper::ReleasePooledChunks() {
+  if (v8_flags.trace_unmapper) {
+    PrintIsolate(heap_->isolate(),
+                 "Unmapper::ReleasePooledChunks: %zu pooled chunks\n",
+                 NumberOfPooledChunks());
+  }
+  FreePooledChunksAboveLimit(0, nullptr);
+}
+
+void MemoryAllocator::Unmapper::FreePooledChunksAboveLimit(
+    size_t limit, JobDelegate* delegate) {
+  MemoryChunk* chunk = nullptr;
+  while ((chunk = GetPooledMemoryChunkAboveLimitSafe(limit)) != nullptr) {
+    ReleasePoolSlot();
+    allocator_->FreePooledChunk(chunk);
+    if (delegate && delegate->ShouldYield()) return;
+  }
+}
+
 void MemoryAllocator::Unmapper::PerformFreeMemoryOnQueuedNonRegularChunks(
     JobDelegate* delegate) {
   MemoryChunk* chunk = nullptr;
@@ -171,10 +195,11 @@ void MemoryAllocator::Unmapper::PerformFreeMemoryOnQueuedChunks(
     // The previous loop uncommitted any pages marked as pooled and added them
     // to the pooled list. In case of kFreePooled we need to free them though as
     // well.
-    while ((chunk = GetMemoryChunkSafe(ChunkQueueType::kPooled)) != nullptr) {
-      allocator_->FreePooledChunk(chunk);
-      if (delegate && delegate->ShouldYield()) return;
-    }
+    FreePooledChunksAboveLimit(0, delegate);
+    if (delegate && delegate->ShouldYield()) return;
+  } else if (mode == MemoryAllocator::Unmapper::FreeMode::kTrimPooled) {
+    FreePooledChunksAboveLimit(v8_flags.max_pooled_pages, delegate);
+    if (delegate && delegate->ShouldYield()) return;
   }
   PerformFreeMemoryOnQueuedNonRegularChunks();
 }
@@ -193,6 +218,11 @@ size_t MemoryAllocator::Unmapper::NumberOfCommittedChunks() {
          chunks_[ChunkQueueType::kNonRegular].size();
 }
 
+size_t MemoryAllocator::Unmapper::NumberOfPooledChunks() {
+  base::MutexGuard guard(&mutex_);
+  return chunks_[ChunkQueueType::kPooled].size();
+}
+
 int MemoryAllocator::Unmapper::NumberOfChunks() {
   base::MutexGuard guard(&mutex_);
   size_t result = 0;
@@ -537,7 +567,10 @@ void MemoryAllocator::Free(MemoryAllocator::FreeMode mode, MemoryChunk* chunk) {
     case FreeMode::kConcurrentlyAndPool:
       DCHECK_EQ(chunk->size(), static_cast<size_t>(MemoryChunk::kPageSize));
       DCHECK_EQ(chunk->executable(), NOT_EXECUTABLE);
-      chunk->SetFlag(MemoryChunk::POOLED);
+      // A full pool falls back to unmapping the chunk.
+      if (unmapper()->TryReservePoolSlot()) {
+        chunk->SetFlag(MemoryChunk::POOLED);
+      }
       V8_FALLTHROUGH;
     case FreeMode::kConcurrently:
       PreFreeMemory(chunk);
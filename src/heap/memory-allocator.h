@@ -5,7 +5,9 @@
 #ifndef V8_HEAP_MEMORY_ALLOCATOR_H_
 #define V8_HEAP_MEMORY_ALLOCATOR_H_
 
+#include <algorithm>
 #include <atomic>
+#include <functional>
 #include <memory>
 #include <unordered_map>
 #include <unordered_set>
@@ -18,6 +20,7 @@
 #include "src/base/platform/mutex.h"
 #include "src/base/platform/semaphore.h"
 #include "src/common/globals.h"
+#include "src/flags/flags.h"
 #include "src/heap/basic-memory-chunk.h"
 #include "src/heap/code-range.h"
 #include "src/heap/memory-chunk.h"
@@ -64,24 +67,41 @@ class MemoryAllocator {
       // been uncommitted.
       // (2) Try to steal any memory chunk of kPageSize that would've been
       // uncommitted.
-      MemoryChunk* chunk = GetMemoryChunkSafe(ChunkQueueType::kPooled);
-      if (chunk == nullptr) {
-        chunk = GetMemoryChunkSafe(ChunkQueueType::kRegular);
-        if (chunk != nullptr) {
-          // For stolen chunks we need to manually free any allocated memory.
-          chunk->ReleaseAllAllocatedMemory();
-        }
+      MemoryChunk* chunk = GetPooledMemoryChunkSafe();
+      if (chunk != nullptr) return chunk;
+      chunk = GetMemoryChunkSafe(ChunkQueueType::kRegular);
+      if (chunk != nullptr) {
+        // Stolen chunks are still committed, so their header can be read.
+        if (chunk->IsFlagSet(MemoryChunk::POOLED)) ReleasePoolSlot();
+        // For stolen chunks we need to manually free any allocated memory.
+        chunk->ReleaseAllAllocatedMemory();
       }
       return chunk;
     }
 
+    // Reserves a slot in the pool for a chunk that is about to be freed.
+    // Returns false if the pool already holds --max-pooled-pages chunks, in
+    // which case the chunk should be unmapped instead.
+    bool TryReservePoolSlot() {
+      base::MutexGuard guard(&mutex_);
+      if (pooled_chunks_ >= v8_flags.max_pooled_pages) return false;
+      pooled_chunks_++;
+      return true;
+    }
+
     V8_EXPORT_PRIVATE void FreeQueuedChunks();
     void CancelAndWaitForPendingTasks();
     void PrepareForGC();
     V8_EXPORT_PRIVATE void EnsureUnmappingCompleted();
+    // Same as above but keeps up to --max-pooled-pages uncommitted chunks in
+    // the pool, so that they can be reused without another mmap.
+    V8_EXPORT_PRIVATE void EnsureUnmappingCompletedAndTrimPool();
+    // Frees all pooled chunks. Used when the heap is considered idle.
+    V8_EXPORT_PRIVATE void ReleasePooledChunks();
     V8_EXPORT_PRIVATE void TearDown();
     size_t NumberOfCommittedChunks();
     V8_EXPORT_PRIVATE int NumberOfChunks();
+    V8_EXPORT_PRIVATE size_t NumberOfPooledChunks();
     size_t CommittedBufferedMemory();
 
     // Returns true when Unmapper task may be running.
@@ -105,10 +125,23 @@ class MemoryAllocator {
 
       // Free pooled pages. Only used on tear down and last-resort GCs.
       kFreePooled,
+
+      // Free pooled pages exceeding --max-pooled-pages.
+      kTrimPooled,
     };
 
     void AddMemoryChunkSafe(ChunkQueueType type, MemoryChunk* chunk) {
       base::MutexGuard guard(&mutex_);
+      if (type == ChunkQueueType::kPooled) {
+        // Keep the pool sorted by descending address. Reusing the lowest
+        // chunks first keeps the heap dense, which gives the OS a better
+        // chance of backing contiguous runs of pages with huge pages.
+        auto& pool = chunks_[type];
+        pool.insert(std::upper_bound(pool.begin(), pool.end(), chunk,
+                                     std::greater<MemoryChunk*>()),
+                    chunk);
+        return;
+      }
       chunks_[type].push_back(chunk);
     }
 
@@ -120,8 +153,41 @@ class MemoryAllocator {
       return chunk;
     }
 
+    // Removes a chunk from the pool and releases its slot. The chunk is
+    // uncommitted, so its header must not be accessed before it is committed
+    // again.
+    MemoryChunk* GetPooledMemoryChunkSafe() {
+      base::MutexGuard guard(&mutex_);
+      auto& pool = chunks_[ChunkQueueType::kPooled];
+      if (pool.empty()) return nullptr;
+      MemoryChunk* chunk = pool.back();
+      pool.pop_back();
+      DCHECK_LT(0, pooled_chunks_);
+      pooled_chunks_--;
+      return chunk;
+    }
+
+    // Removes the highest chunk from the pool if it holds more than |limit|
+    // chunks.
+    MemoryChunk* GetPooledMemoryChunkAboveLimitSafe(size_t limit) {
+      base::MutexGuard guard(&mutex_);
+      auto& pool = chunks_[ChunkQueueType::kPooled];
+      if (pool.size() <= limit) return nullptr;
+      MemoryChunk* chunk = pool.front();
+      pool.erase(pool.begin());
+      return chunk;
+    }
+
+    void ReleasePoolSlot() {
+      base::MutexGuard guard(&mutex_);
+      DCHECK_LT(0, pooled_chunks_);
+      pooled_chunks_--;
+    }
+
     bool MakeRoomForNewTasks();
 
+    void FreePooledChunksAboveLimit(size_t limit, JobDelegate* delegate);
+
     void PerformFreeMemoryOnQueuedChunks(FreeMode mode,
                                          JobDelegate* delegate = nullptr);
 
@@ -132,6 +198,9 @@ class MemoryAllocator {
     MemoryAllocator* const allocator_;
     base::Mutex mutex_;
     std::vector<MemoryChunk*> chunks_[ChunkQueueType::kNumberOfChunkQueues];
+    // Number of chunks flagged as POOLED, including the ones that are queued
+    // but not yet uncommitted.
+    size_t pooled_chunks_ = 0;
     std::unique_ptr<v8::JobHandle> job_handle_;
 
     friend class MemoryAllocator;
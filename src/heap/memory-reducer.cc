@@ -8,6 +8,7 @@
 #include "src/heap/gc-tracer.h"
 #include "src/heap/heap-inl.h"
 #include "src/heap/incremental-marking.h"
+#include "src/heap/memory-allocator.h"
 #include "src/init/v8.h"
 #include "src/utils/utils.h"
 
@@ -111,6 +112,11 @@ void MemoryReducer::NotifyMarkCompact(const Event& event) {
           "Memory reducer: finished GC #%d (%s)\n", state_.started_gcs,
           state_.action == kWait ? "will do more" : "done");
     }
+    if (state_.action == kDone) {
+      // The heap is considered idle, so there is no point in keeping pooled
+      // pages around for quick reuse.
+      heap()->memory_allocator()->unmapper()->ReleasePooledChunks();
+    }
   }
 }
 
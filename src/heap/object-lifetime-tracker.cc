@@ -0,0 +1,116 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/heap/object-lifetime-tracker.h"
+
+#include <algorithm>
+
+#include "src/api/api-inl.h"
+#include "src/execution/isolate.h"
+#include "src/heap/heap-inl.h"
+#include "src/logging/counters.h"
+#include "src/utils/ostreams.h"
+
+namespace v8 {
+namespace internal {
+
+ObjectLifetimeTracker::ObjectLifetimeTracker(Heap* heap,
+                                             intptr_t sample_interval)
+    : AllocationObserver(sample_interval), heap_(heap) {}
+
+ObjectLifetimeTracker::~ObjectLifetimeTracker() = default;
+
+void ObjectLifetimeTracker::Step(int bytes_allocated, Address soon_object,
+                                 size_t size) {
+  DCHECK_EQ(Heap::NOT_IN_GC, heap_->gc_state());
+  if (!soon_object) return;
+  DisallowGarbageCollection no_gc;
+  Isolate* isolate = heap_->isolate();
+  // The area has been made iterable, but the object is not initialized yet.
+  DCHECK(HeapObject::FromAddress(soon_object).map(isolate).IsMap(isolate));
+  HandleScope scope(isolate);
+  Handle<Object> obj(HeapObject::FromAddress(soon_object), isolate);
+  auto sample =
+      std::make_unique<Sample>(reinterpret_cast<v8::Isolate*>(isolate),
+                               v8::Utils::ToLocal(obj), this, young_gcs_);
+  sample->global.SetWeak(sample.get(), OnWeakCallback,
+                         WeakCallbackType::kParameter);
+  samples_.emplace(sample.get(), std::move(sample));
+}
+
+void ObjectLifetimeTracker::NotifyGCPrologue() {
+  v8::Isolate* isolate = reinterpret_cast<v8::Isolate*>(heap_->isolate());
+  for (auto& [sample, unused] : samples_) {
+    if (sample->has_type) continue;
+    HandleScope scope(heap_->isolate());
+    Handle<Object> obj = Utils::OpenHandle(*sample->global.Get(isolate));
+    sample->type = HeapObject::cast(*obj).map().instance_type();
+    sample->has_type = true;
+  }
+}
+
+void ObjectLifetimeTracker::NotifyGCEpilogue(GarbageCollector collector) {
+  if (Heap::IsYoungGenerationCollector(collector)) young_gcs_++;
+  v8::Isolate* isolate = reinterpret_cast<v8::Isolate*>(heap_->isolate());
+  Histogram* histogram =
+      heap_->isolate()->counters()->gc_object_age_at_promotion();
+  for (auto it = samples_.begin(); it != samples_.end();) {
+    Sample* sample = it->first;
+    HandleScope scope(heap_->isolate());
+    Handle<Object> obj = Utils::OpenHandle(*sample->global.Get(isolate));
+    if (Heap::InYoungGeneration(*obj)) {
+      ++it;
+      continue;
+    }
+    if (sample->has_type) {
+      const int age = AgeOf(*sample);
+      promotions_[sample->type][age]++;
+      histogram->AddSample(age);
+    }
+    it = samples_.erase(it);
+  }
+}
+
+// static
+void ObjectLifetimeTracker::OnWeakCallback(
+    const WeakCallbackInfo<Sample>& data) {
+  Sample* sample = data.GetParameter();
+  ObjectLifetimeTracker* tracker = sample->tracker;
+  // Objects that die in a GC that skipped the prologue are not recorded.
+  if (sample->has_type) {
+    const int age = tracker->AgeOf(*sample);
+    tracker->deaths_[sample->type][age]++;
+    tracker->heap_->isolate()->counters()->gc_object_age_at_death()->AddSample(
+        age);
+  }
+  tracker->samples_.erase(sample);
+  // sample is deleted because its unique ptr was erased from samples_.
+}
+
+int ObjectLifetimeTracker::AgeOf(const Sample& sample) const {
+  return std::min(young_gcs_ - sample.birth, kMaxAge);
+}
+
+void ObjectLifetimeTracker::Print() const {
+  StdoutStream os;
+  os << "Object lifetimes in young generation GCs (";
+  os << "died|promoted at age 0.." << kMaxAge << "+):" << std::endl;
+  for (int type = 0; type <= LAST_TYPE; type++) {
+    const AgeHistogram& died = deaths_[type];
+    const AgeHistogram& promoted = promotions_[type];
+    auto is_zero = [](size_t count) { return count == 0; };
+    if (std::all_of(died.begin(), died.end(), is_zero) &&
+        std::all_of(promoted.begin(), promoted.end(), is_zero)) {
+      continue;
+    }
+    os << "  " << static_cast<InstanceType>(type) << ":";
+    for (size_t count : died) os << " " << count;
+    os << " |";
+    for (size_t count : promoted) os << " " << count;
+    os << std::endl;
+  }
+}
+
+}  // namespace internal
+}  // namespace v8
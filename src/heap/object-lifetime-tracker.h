@@ -0,0 +1,90 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_HEAP_OBJECT_LIFETIME_TRACKER_H_
+#define V8_HEAP_OBJECT_LIFETIME_TRACKER_H_
+
+#include <array>
+#include <memory>
+#include <unordered_map>
+
+#include "include/v8-persistent-handle.h"
+#include "include/v8-weak-callback-info.h"
+#include "src/common/globals.h"
+#include "src/heap/allocation-observer.h"
+#include "src/objects/instance-type.h"
+
+namespace v8 {
+namespace internal {
+
+class Heap;
+
+// Samples young generation allocations and records the age of the sampled
+// objects, i.e. the number of young generation GCs they survived, when they
+// die or get promoted. Ages are bucketed by instance type. Enabled with
+// --track-object-lifetimes; the histograms are reported to the
+// V8.GCObjectAgeAt{Death,Promotion} counters and printed on teardown with
+// --trace-object-lifetimes.
+class V8_EXPORT_PRIVATE ObjectLifetimeTracker final
+    : public AllocationObserver {
+ public:
+  // Ages above this are recorded in the last bucket.
+  static constexpr int kMaxAge = 8;
+  using AgeHistogram = std::array<size_t, kMaxAge + 1>;
+
+  ObjectLifetimeTracker(Heap* heap, intptr_t sample_interval);
+  ~ObjectLifetimeTracker() override;
+
+  // Resolves the instance types of objects sampled since the last GC. Must be
+  // called before every GC.
+  void NotifyGCPrologue();
+  // Ages sampled objects and records promotions. Must be called after every
+  // GC.
+  void NotifyGCEpilogue(GarbageCollector collector);
+
+  const AgeHistogram& deaths(InstanceType type) const {
+    return deaths_[type];
+  }
+  const AgeHistogram& promotions(InstanceType type) const {
+    return promotions_[type];
+  }
+  size_t tracked_samples() const { return samples_.size(); }
+
+  void Print() const;
+
+ protected:
+  void Step(int bytes_allocated, Address soon_object, size_t size) final;
+
+ private:
+  struct Sample {
+    Sample(v8::Isolate* isolate, Local<Value> local,
+           ObjectLifetimeTracker* tracker, int birth)
+        : global(isolate, local), tracker(tracker), birth(birth) {}
+    Sample(const Sample&) = delete;
+    Sample& operator=(const Sample&) = delete;
+
+    Global<Value> global;
+    ObjectLifetimeTracker* const tracker;
+    // Number of young generation GCs before the object was allocated.
+    const int birth;
+    // Only known after the allocation is complete.
+    InstanceType type = FIRST_TYPE;
+    bool has_type = false;
+  };
+
+  static void OnWeakCallback(const WeakCallbackInfo<Sample>& data);
+
+  int AgeOf(const Sample& sample) const;
+
+  Heap* const heap_;
+  int young_gcs_ = 0;
+  std::unordered_map<Sample*, std::unique_ptr<Sample>> samples_;
+  std::array<AgeHistogram, LAST_TYPE + 1> deaths_{};
+  std::array<AgeHistogram, LAST_TYPE + 1> promotions_{};
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_HEAP_OBJECT_LIFETIME_TRACKER_H_
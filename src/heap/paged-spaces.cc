@@ -389,9 +389,21 @@ void PagedSpaceBase::ShrinkImmortalImmovablePages() {
   }
 }
 
+namespace {
+
+// Regular data pages are taken from and released to the page pool of the
+// memory allocator.
+MemoryAllocator::AllocationMode PageAllocationMode(Executability executable) {
+  return v8_flags.pool_old_generation_pages && executable == NOT_EXECUTABLE
+             ? MemoryAllocator::AllocationMode::kUsePool
+             : MemoryAllocator::AllocationMode::kRegular;
+}
+
+}  // namespace
+
 Page* PagedSpaceBase::TryExpandImpl() {
   Page* page = heap()->memory_allocator()->AllocatePage(
-      MemoryAllocator::AllocationMode::kRegular, this, executable());
+      PageAllocationMode(executable()), this, executable());
   if (page == nullptr) return nullptr;
   ConcurrentAllocationMutex guard(this);
   AddPage(page);
@@ -404,7 +416,7 @@ base::Optional<std::pair<Address, size_t>> PagedSpaceBase::TryExpandBackground(
     size_t size_in_bytes) {
   DCHECK_NE(NEW_SPACE, identity());
   Page* page = heap()->memory_allocator()->AllocatePage(
-      MemoryAllocator::AllocationMode::kRegular, this, executable());
+      PageAllocationMode(executable()), this, executable());
   if (page == nullptr) return {};
   base::MutexGuard lock(&space_mutex_);
   AddPage(page);
@@ -572,8 +584,15 @@ void PagedSpaceBase::ReleasePage(Page* page) {
   AccountUncommitted(page->size());
   DecrementCommittedPhysicalMemory(page->CommittedPhysicalMemory());
   accounting_stats_.DecreaseCapacity(page->area_size());
-  heap()->memory_allocator()->Free(MemoryAllocator::FreeMode::kConcurrently,
-                                   page);
+  // Only regular data pages fit into the pool. Shrunk pages and code pages
+  // are always unmapped.
+  const bool can_pool = PageAllocationMode(executable()) ==
+                            MemoryAllocator::AllocationMode::kUsePool &&
+                        page->size() == static_cast<size_t>(Page::kPageSize);
+  heap()->memory_allocator()->Free(
+      can_pool ? MemoryAllocator::FreeMode::kConcurrentlyAndPool
+               : MemoryAllocator::FreeMode::kConcurrently,
+      page);
 }
 
 void PagedSpaceBase::SetReadable() {
@@ -917,6 +936,17 @@ bool PagedSpaceBase::RawRefillLabMain(int size_in_bytes,
       if (ContributeToSweepingMain(size_in_bytes, kMaxPagesToSweep,
                                    size_in_bytes, origin))
         return true;
+      if (identity() == NEW_SPACE) {
+        // New space pages are swept concurrently while the mutator allocates.
+        // Keep contributing a single page at a time and pick up pages that
+        // were swept concurrently in the meantime, instead of finishing
+        // sweeping of all remaining pages below.
+        while (heap()->sweeper()->HasPendingPagesForSpace(NEW_SPACE)) {
+          if (ContributeToSweepingMain(size_in_bytes, kMaxPagesToSweep,
+                                       size_in_bytes, origin))
+            return true;
+        }
+      }
     }
   }
 
@@ -35,7 +35,11 @@ void PretenuringHandler::MergeAllocationSitePretenuringFeedback(
 
     const int value = static_cast<int>(site_and_count.second);
     DCHECK_LT(0, value);
-    if (site.IncrementMementoFoundCount(value)) {
+    // Tenured sites are digested even with few surviving mementos, as that
+    // is exactly the feedback needed for untenuring them.
+    if (site.IncrementMementoFoundCount(value) ||
+        (v8_flags.allocation_site_pretenuring_decay &&
+         site.GetAllocationType() == AllocationType::kOld)) {
       // For sites in the global map the count is accessed through the site.
       global_pretenuring_feedback_.insert(std::make_pair(site, 0));
     }
@@ -50,13 +54,21 @@ bool PretenuringHandler::DeoptMaybeTenuredAllocationSites() const {
 
 namespace {
 
+// Survival ratio below which a tenured site is moved back to young
+// allocation when --allocation-site-pretenuring-decay is enabled. The gap to
+// AllocationSite::kPretenureRatio avoids flip-flopping between decisions.
+constexpr double kUnpretenureRatio = 0.5;
+
 inline bool MakePretenureDecision(
     AllocationSite site, AllocationSite::PretenureDecision current_decision,
     double ratio, bool maximum_size_scavenge) {
   // Here we just allow state transitions from undecided or maybe tenure
-  // to don't tenure, maybe tenure, or tenure.
-  if ((current_decision == AllocationSite::kUndecided ||
-       current_decision == AllocationSite::kMaybeTenure)) {
+  // to don't tenure, maybe tenure, or tenure. With decaying feedback don't
+  // tenure sites may be reconsidered and tenured sites may be untenured.
+  const bool revisit = v8_flags.allocation_site_pretenuring_decay;
+  if (current_decision == AllocationSite::kUndecided ||
+      current_decision == AllocationSite::kMaybeTenure ||
+      (revisit && current_decision == AllocationSite::kDontTenure)) {
     if (ratio >= AllocationSite::kPretenureRatio) {
       // We just transition into tenure state when the semi-space was at
       // maximum capacity.
@@ -71,12 +83,27 @@ inline bool MakePretenureDecision(
     } else {
       site.set_pretenure_decision(AllocationSite::kDontTenure);
     }
+  } else if (revisit && current_decision == AllocationSite::kTenure &&
+             ratio < kUnpretenureRatio) {
+    // Feedback for tenured sites only comes from unoptimized code, which
+    // keeps allocating young objects with mementos. Optimized code has to be
+    // deoptimized to stop allocating in old space.
+    site.set_deopt_dependent_code(true);
+    site.set_pretenure_decision(AllocationSite::kDontTenure);
+    return true;
   }
   return false;
 }
 
-// Clear feedback calculation fields until the next gc.
+// Clear feedback calculation fields until the next gc. With decay enabled
+// half of the feedback is kept, so that the ratio reflects an exponentially
+// weighted history of the site instead of only the last cycle.
 inline void ResetPretenuringFeedback(AllocationSite site) {
+  if (v8_flags.allocation_site_pretenuring_decay) {
+    site.set_memento_found_count(site.memento_found_count() / 2);
+    site.set_memento_create_count(site.memento_create_count() / 2);
+    return;
+  }
   site.set_memento_found_count(0);
   site.set_memento_create_count(0);
 }
@@ -100,16 +127,19 @@ inline bool DigestPretenuringFeedback(Isolate* isolate, AllocationSite site,
                                   maximum_size_scavenge);
   }
 
+  ResetPretenuringFeedback(site);
+
   if (v8_flags.trace_pretenuring_statistics) {
     PrintIsolate(isolate,
                  "pretenuring: AllocationSite(%p): (created, found, ratio) "
-                 "(%d, %d, %f) %s => %s\n",
+                 "(%d, %d, %f) %s => %s%s kept (%d, %d)\n",
                  reinterpret_cast<void*>(site.ptr()), create_count, found_count,
                  ratio, site.PretenureDecisionName(current_decision),
-                 site.PretenureDecisionName(site.pretenure_decision()));
+                 site.PretenureDecisionName(site.pretenure_decision()),
+                 deopt ? " (deopt)" : "", site.memento_create_count(),
+                 site.memento_found_count());
   }
 
-  ResetPretenuringFeedback(site);
   return deopt;
 }
 
@@ -182,7 +212,32 @@ void PretenuringHandler::ProcessPretenuringFeedback() {
       }
     }
 
-    // Step 2: Pretenure allocation sites for manual requests.
+    // Step 2: With decaying feedback, tenured sites none of whose mementos
+    // survived have no entry in the feedback storage but still need to be
+    // digested, as that is what moves them back to young allocation.
+    if (v8_flags.allocation_site_pretenuring_decay) {
+      heap_->ForeachAllocationSite(
+          heap_->allocation_sites_list(),
+          [this, &allocation_sites, &trigger_deoptimization,
+           &dont_tenure_decisions, maximum_size_scavenge](AllocationSite site) {
+            DCHECK(site.IsAllocationSite());
+            if (site.GetAllocationType() != AllocationType::kOld ||
+                site.memento_create_count() == 0 ||
+                global_pretenuring_feedback_.count(site) > 0) {
+              return;
+            }
+            allocation_sites++;
+            if (DigestPretenuringFeedback(heap_->isolate(), site,
+                                          maximum_size_scavenge)) {
+              trigger_deoptimization = true;
+            }
+            if (site.GetAllocationType() == AllocationType::kYoung) {
+              dont_tenure_decisions++;
+            }
+          });
+    }
+
+    // Step 3: Pretenure allocation sites for manual requests.
     if (allocation_sites_to_pretenure_) {
       while (!allocation_sites_to_pretenure_->empty()) {
         auto pretenure_site = allocation_sites_to_pretenure_->Pop();
@@ -193,7 +248,7 @@ void PretenuringHandler::ProcessPretenuringFeedback() {
       allocation_sites_to_pretenure_.reset();
     }
 
-    // Step 3: Deopt maybe tenured allocation sites if necessary.
+    // Step 4: Deopt maybe tenured allocation sites if necessary.
     bool deopt_maybe_tenured = DeoptMaybeTenuredAllocationSites();
     if (deopt_maybe_tenured) {
       heap_->ForeachAllocationSite(
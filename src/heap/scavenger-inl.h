@@ -62,6 +62,11 @@ bool Scavenger::PromotionList::Local::IsGlobalPoolEmpty() const {
          large_object_promotion_list_local_.IsGlobalEmpty();
 }
 
+bool Scavenger::PromotionList::Local::IsLocalEmpty() const {
+  return regular_object_promotion_list_local_.IsLocalEmpty() &&
+         large_object_promotion_list_local_.IsLocalEmpty();
+}
+
 bool Scavenger::PromotionList::Local::ShouldEagerlyProcessPromotionList()
     const {
   // Threshold when to prioritize processing of the promotion list. Right
@@ -4,6 +4,8 @@
 
 #include "src/heap/scavenger.h"
 
+#include <algorithm>
+
 #include "src/common/globals.h"
 #include "src/handles/global-handles.h"
 #include "src/heap/array-buffer-sweeper.h"
@@ -183,6 +185,17 @@ bool IsUnscavengedHeapObjectSlot(Heap* heap, FullObjectSlot p) {
   return IsUnscavengedHeapObject(heap, *p);
 }
 
+// Returns an estimate for the work needed to process the old-to-new
+// remembered set of |chunk|.
+size_t EstimateOldToNewWork(MemoryChunk* chunk) {
+  SlotSet* slot_set = chunk->slot_set<OLD_TO_NEW, AccessMode::NON_ATOMIC>();
+  size_t work =
+      slot_set ? slot_set->NumberOfAllocatedBuckets(chunk->buckets()) : 0;
+  // Typed slots are only recorded on code pages and are comparatively rare.
+  if (chunk->typed_slot_set<OLD_TO_NEW, AccessMode::NON_ATOMIC>()) work++;
+  return work;
+}
+
 }  // namespace
 
 ScavengerCollector::JobTask::JobTask(
@@ -236,6 +249,7 @@ void ScavengerCollector::JobTask::ProcessItems(JobDelegate* delegate,
     ConcurrentScavengePages(scavenger);
     scavenger->Process(delegate);
   }
+  scavenger->AddParallelScavengingTime(scavenging_time);
   if (v8_flags.trace_parallel_scavenge) {
     PrintIsolate(outer_->heap_->isolate(),
                  "scavenge[%p]: time=%.2f copied=%zu promoted=%zu\n",
@@ -351,11 +365,24 @@ void ScavengerCollector::CollectGarbage() {
                         &promotion_list, &ephemeron_table_list, i));
     }
 
-    std::vector<std::pair<ParallelWorkItem, MemoryChunk*>> memory_chunks;
+    std::vector<std::pair<size_t, MemoryChunk*>> chunks_by_work;
     RememberedSet<OLD_TO_NEW>::IterateMemoryChunks(
-        heap_, [&memory_chunks](MemoryChunk* chunk) {
-          memory_chunks.emplace_back(ParallelWorkItem{}, chunk);
+        heap_, [&chunks_by_work](MemoryChunk* chunk) {
+          chunks_by_work.emplace_back(EstimateOldToNewWork(chunk), chunk);
         });
+    // Hand out the pages with the densest remembered sets first. Otherwise a
+    // large page picked up last can keep a single task busy while all other
+    // tasks are already idle.
+    std::stable_sort(chunks_by_work.begin(), chunks_by_work.end(),
+                     [](const std::pair<size_t, MemoryChunk*>& a,
+                        const std::pair<size_t, MemoryChunk*>& b) {
+                       return a.first > b.first;
+                     });
+    std::vector<std::pair<ParallelWorkItem, MemoryChunk*>> memory_chunks;
+    memory_chunks.reserve(chunks_by_work.size());
+    for (auto& entry : chunks_by_work) {
+      memory_chunks.emplace_back(ParallelWorkItem{}, entry.second);
+    }
 
     RootScavengeVisitor root_scavenge_visitor(scavengers[kMainThreadId].get());
 
@@ -388,14 +415,19 @@ void ScavengerCollector::CollectGarbage() {
     {
       // Parallel phase scavenging all copied and promoted objects.
       TRACE_GC(heap_->tracer(), GCTracer::Scope::SCAVENGER_SCAVENGE_PARALLEL);
-      V8::GetCurrentPlatform()
-          ->CreateJob(v8::TaskPriority::kUserBlocking,
-                      std::make_unique<JobTask>(this, &scavengers,
-                                                std::move(memory_chunks),
-                                                &copied_list, &promotion_list))
-          ->Join();
+      double parallel_phase_time = 0.0;
+      {
+        TimedScope scope(&parallel_phase_time);
+        V8::GetCurrentPlatform()
+            ->CreateJob(v8::TaskPriority::kUserBlocking,
+                        std::make_unique<JobTask>(
+                            this, &scavengers, std::move(memory_chunks),
+                            &copied_list, &promotion_list))
+            ->Join();
+      }
       DCHECK(copied_list.IsEmpty());
       DCHECK(promotion_list.IsEmpty());
+      ReportParallelScavengingTimes(scavengers, parallel_phase_time);
     }
 
     if (V8_UNLIKELY(v8_flags.scavenge_separate_stack_scanning)) {
@@ -575,6 +607,31 @@ void ScavengerCollector::MergeSurvivingNewLargeObjects(
   }
 }
 
+void ScavengerCollector::ReportParallelScavengingTimes(
+    const std::vector<std::unique_ptr<Scavenger>>& scavengers,
+    double parallel_phase_time_ms) {
+  // Tasks that did not participate in the parallel phase are not accounted as
+  // idle as they never occupied a worker thread.
+  int participating_tasks = 0;
+  double busy_time_ms = 0.0;
+  double idle_time_ms = 0.0;
+  for (size_t i = 0; i < scavengers.size(); ++i) {
+    const double task_busy_time = scavengers[i]->parallel_scavenging_time();
+    if (task_busy_time == 0.0) continue;
+    const double task_idle_time =
+        std::max(0.0, parallel_phase_time_ms - task_busy_time);
+    participating_tasks++;
+    busy_time_ms += task_busy_time;
+    idle_time_ms += task_idle_time;
+    if (v8_flags.trace_parallel_scavenge) {
+      PrintIsolate(isolate_, "scavenge[task %zu]: busy=%.2f idle=%.2f\n", i,
+                   task_busy_time, task_idle_time);
+    }
+  }
+  heap_->tracer()->AddScavengerParallelWork(busy_time_ms, idle_time_ms,
+                                            participating_tasks);
+}
+
 int ScavengerCollector::NumberOfScavengeTasks() {
   if (!v8_flags.parallel_scavenge) return 1;
   const int num_scavenge_tasks =
@@ -631,7 +688,8 @@ Scavenger::Scavenger(ScavengerCollector* collector, Heap* heap, bool is_logging,
       shared_string_table_(shared_old_allocator_.get() != nullptr),
       mark_shared_heap_(heap->isolate()->is_shared_space_isolate()),
       shortcut_strings_(!heap->IsGCWithStack() ||
-                        v8_flags.shortcut_strings_with_stack) {}
+                        v8_flags.shortcut_strings_with_stack),
+      share_work_(v8_flags.scavenge_work_sharing) {}
 
 void Scavenger::IterateAndScavengePromotedObject(HeapObject target, Map map,
                                                  int size) {
@@ -719,6 +777,17 @@ void Scavenger::ScavengePage(MemoryChunk* page) {
   AddPageToSweeperIfNecessary(page);
 }
 
+void Scavenger::ShareWork() {
+  if (!copied_list_local_.IsLocalEmpty() &&
+      copied_list_local_.IsGlobalEmpty()) {
+    copied_list_local_.Publish();
+  }
+  if (!promotion_list_local_.IsLocalEmpty() &&
+      promotion_list_local_.IsGlobalPoolEmpty()) {
+    promotion_list_local_.Publish();
+  }
+}
+
 void Scavenger::Process(JobDelegate* delegate) {
   ScavengeVisitor scavenge_visitor(this);
 
@@ -733,6 +802,8 @@ void Scavenger::Process(JobDelegate* delegate) {
       done = false;
       if (delegate && ((++objects % kInterruptThreshold) == 0)) {
         if (!copied_list_local_.IsLocalEmpty()) {
+          // Local work is invisible to other tasks until it is published.
+          if (share_work_) ShareWork();
           delegate->NotifyConcurrencyIncrease();
         }
       }
@@ -744,6 +815,7 @@ void Scavenger::Process(JobDelegate* delegate) {
       IterateAndScavengePromotedObject(target, entry.map, entry.size);
       done = false;
       if (delegate && ((++objects % kInterruptThreshold) == 0)) {
+        if (share_work_) ShareWork();
         if (!promotion_list_local_.IsGlobalPoolEmpty()) {
           delegate->NotifyConcurrencyIncrease();
         }
@@ -68,6 +68,7 @@ class Scavenger {
       inline size_t LocalPushSegmentSize() const;
       inline bool Pop(struct PromotionListEntry* entry);
       inline bool IsGlobalPoolEmpty() const;
+      inline bool IsLocalEmpty() const;
       inline bool ShouldEagerlyProcessPromotionList() const;
       inline void Publish();
 
@@ -112,6 +113,13 @@ class Scavenger {
   size_t bytes_copied() const { return copied_size_; }
   size_t bytes_promoted() const { return promoted_size_; }
 
+  // Time (in ms) this scavenger spent processing work in the parallel phase.
+  // Only accessed by the task that currently owns the scavenger.
+  double parallel_scavenging_time() const { return parallel_scavenging_time_; }
+  void AddParallelScavengingTime(double time_ms) {
+    parallel_scavenging_time_ += time_ms;
+  }
+
  private:
   enum PromotionHeapChoice { kPromoteIntoLocalHeap, kPromoteIntoSharedHeap };
 
@@ -125,6 +133,10 @@ class Scavenger {
 
   void AddPageToSweeperIfNecessary(MemoryChunk* page);
 
+  // Publishes thread-local work in case the global pools are empty so that
+  // other tasks that ran out of work can steal it.
+  void ShareWork();
+
   // Potentially scavenges an object referenced from |slot| if it is
   // indeed a HeapObject and resides in from space.
   template <typename TSlot>
@@ -206,6 +218,7 @@ class Scavenger {
   PretenuringHandler::PretenuringFeedbackMap local_pretenuring_feedback_;
   size_t copied_size_;
   size_t promoted_size_;
+  double parallel_scavenging_time_ = 0.0;
   EvacuationAllocator allocator_;
   std::unique_ptr<ConcurrentAllocator> shared_old_allocator_;
   SurvivingNewLargeObjectsMap surviving_new_large_objects_;
@@ -217,6 +230,7 @@ class Scavenger {
   const bool shared_string_table_;
   const bool mark_shared_heap_;
   const bool shortcut_strings_;
+  const bool share_work_;
 
   friend class IterateAndScavengePromotedObjectsVisitor;
   friend class RootScavengeVisitor;
@@ -282,6 +296,11 @@ class ScavengerCollector {
 
   int NumberOfScavengeTasks();
 
+  // Reports per-task busy and idle times of the parallel phase to the tracer.
+  void ReportParallelScavengingTimes(
+      const std::vector<std::unique_ptr<Scavenger>>& scavengers,
+      double parallel_phase_time_ms);
+
   void ProcessWeakReferences(EphemeronTableList* ephemeron_table_list);
   void ClearYoungEphemerons(EphemeronTableList* ephemeron_table_list);
   void ClearOldEphemerons();
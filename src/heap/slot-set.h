@@ -169,6 +169,16 @@ class SlotSet final : public ::heap::base::BasicSlotSet<kTaggedSize> {
         });
   }
 
+  // Returns the number of allocated buckets. Used as a cheap estimate for the
+  // amount of work required to iterate the set.
+  size_t NumberOfAllocatedBuckets(size_t buckets) {
+    size_t allocated = 0;
+    for (size_t bucket_index = 0; bucket_index < buckets; bucket_index++) {
+      if (LoadBucket<AccessMode::NON_ATOMIC>(bucket_index)) allocated++;
+    }
+    return allocated;
+  }
+
   // Check whether possibly empty buckets are really empty. Empty buckets are
   // freed and the possibly empty state is cleared for all buckets.
   bool CheckPossiblyEmptyBuckets(size_t buckets,
@@ -89,7 +89,10 @@ class Sweeper::SweeperJob final : public JobTask {
     const int offset = delegate->GetTaskId();
     DCHECK_LT(offset, concurrent_sweepers_->size());
     ConcurrentSweeper& concurrent_sweeper = (*concurrent_sweepers_)[offset];
-    if (offset > 0) {
+    // With a paged new space the mutator can only resume young generation
+    // allocation on swept pages, so all tasks start with the new space.
+    const bool sweep_new_space_first = offset == 0 || v8_flags.minor_mc;
+    if (!sweep_new_space_first) {
       if (!SweepNonNewSpaces(concurrent_sweeper, delegate, is_joining_thread,
                              offset, kNumberOfSweepingSpaces))
         return;
@@ -100,6 +103,11 @@ class Sweeper::SweeperJob final : public JobTask {
           is_joining_thread ? ThreadKind::kMain : ThreadKind::kBackground);
       if (!concurrent_sweeper.ConcurrentSweepSpace(NEW_SPACE, delegate)) return;
     }
+    if (sweep_new_space_first && offset > 0) {
+      if (!SweepNonNewSpaces(concurrent_sweeper, delegate, is_joining_thread,
+                             offset, kNumberOfSweepingSpaces))
+        return;
+    }
     if (!SweepNonNewSpaces(concurrent_sweeper, delegate, is_joining_thread, 1,
                            offset == 0 ? kNumberOfSweepingSpaces : offset))
       return;
@@ -189,7 +197,8 @@ void Sweeper::StartSweeping(GarbageCollector collector) {
   if (collector == GarbageCollector::MARK_COMPACTOR)
     should_sweep_non_new_spaces_ = true;
   current_new_space_collector_ = collector;
-  should_reduce_memory_ = heap_->ShouldReduceMemory();
+  should_reduce_memory_.store(heap_->ShouldReduceMemory(),
+                              std::memory_order_relaxed);
   ForAllSweepingSpaces([this](AllocationSpace space) {
     // Sorting is done in order to make compaction more efficient: by sweeping
     // pages with the most free bytes first, we make it more likely that when
@@ -307,6 +316,69 @@ void Sweeper::DrainSweepingWorklistForSpace(AllocationSpace space) {
   ParallelSweepSpace(space, SweepingMode::kLazyOrConcurrent, 0);
 }
 
+bool Sweeper::SweepUntilDeadline(double deadline_in_ms) {
+  if (!sweeping_in_progress_) return true;
+  bool deadline_reached = false;
+  ForAllSweepingSpaces([this, deadline_in_ms,
+                        &deadline_reached](AllocationSpace space) {
+    if (deadline_reached) return;
+    if (space != NEW_SPACE && !should_sweep_non_new_spaces_) return;
+    while (Page* page = GetSweepingPageSafe(space)) {
+      ParallelSweepPage(page, space, &local_pretenuring_feedback_,
+                        SweepingMode::kLazyOrConcurrent);
+      if (heap_->MonotonicallyIncreasingTimeInMs() >= deadline_in_ms) {
+        deadline_reached = true;
+        return;
+      }
+    }
+  });
+  return !deadline_reached && IsDoneSweeping();
+}
+
+size_t Sweeper::ReduceMemoryOnMemoryPressure() {
+  should_reduce_memory_.store(true, std::memory_order_relaxed);
+  size_t discarded_bytes = 0;
+  for (AllocationSpace space : {OLD_SPACE, CODE_SPACE}) {
+    discarded_bytes +=
+        DiscardUnusedMemoryOfSweptPages(heap_->paged_space(space));
+  }
+  return discarded_bytes;
+}
+
+size_t Sweeper::DiscardUnusedMemoryOfSweptPages(PagedSpaceBase* space) {
+  // Free list entries are only changed by allocations and by refilling the
+  // free list, both of which happen under the space mutex. Pages that are
+  // still being swept own their free list categories and are skipped.
+  base::MutexGuard guard(space->mutex());
+  const size_t page_size_bits = MemoryAllocator::GetCommitPageSizeBits();
+  size_t discarded_bytes = 0;
+  for (Page* p : *space) {
+    if (!p->SweepingDone()) continue;
+    ActiveSystemPages active_system_pages_after_discarding =
+        *p->active_system_pages();
+    p->ForAllFreeListCategories([p, &active_system_pages_after_discarding,
+                                 page_size_bits](FreeListCategory* category) {
+      category->IterateNodes([p, &active_system_pages_after_discarding,
+                              page_size_bits](FreeSpace node) {
+        base::AddressRegion area = MemoryAllocator::ComputeDiscardMemoryArea(
+            node.address(), node.Size());
+        if (area.size() == 0) return;
+        // Pages that were discarded before and not used since are skipped.
+        if (active_system_pages_after_discarding.Remove(
+                area.begin() - p->address(), area.end() - p->address(),
+                page_size_bits) == 0) {
+          return;
+        }
+        p->DiscardUnusedMemory(node.address(), node.Size());
+      });
+    });
+    discarded_bytes += p->active_system_pages()->Size(page_size_bits);
+    space->ReduceActiveSystemPages(p, active_system_pages_after_discarding);
+    discarded_bytes -= p->active_system_pages()->Size(page_size_bits);
+  }
+  return discarded_bytes;
+}
+
 bool Sweeper::AreSweeperTasksRunning() {
   return job_handle_ && job_handle_->IsValid() && job_handle_->IsActive();
 }
@@ -329,7 +401,8 @@ V8_INLINE void AtomicZapBlock(Address addr, size_t size_in_bytes) {
 
 V8_INLINE size_t Sweeper::FreeAndProcessFreedMemory(
     Address free_start, Address free_end, Page* page, Space* space,
-    FreeSpaceTreatmentMode free_space_treatment_mode) {
+    FreeSpaceTreatmentMode free_space_treatment_mode,
+    bool discard_unused_memory) {
   CHECK_GT(free_end, free_start);
   size_t freed_bytes = 0;
   size_t size = static_cast<size_t>(free_end - free_start);
@@ -339,7 +412,7 @@ V8_INLINE size_t Sweeper::FreeAndProcessFreedMemory(
   page->heap()->CreateFillerObjectAtSweeper(free_start, static_cast<int>(size));
   freed_bytes = reinterpret_cast<PagedSpaceBase*>(space)->UnaccountedFree(
       free_start, size);
-  if (should_reduce_memory_) page->DiscardUnusedMemory(free_start, size);
+  if (discard_unused_memory) page->DiscardUnusedMemory(free_start, size);
 
   return freed_bytes;
 }
@@ -438,8 +511,12 @@ int Sweeper::RawSweep(
   CodeObjectRegistry* code_object_registry = p->GetCodeObjectRegistry();
   std::vector<Address> code_objects;
 
+  // The flag may be set concurrently on memory pressure, so it is read only
+  // once to keep discarding and accounting consistent for this page.
+  const bool discard_unused_memory =
+      should_reduce_memory_.load(std::memory_order_relaxed);
   base::Optional<ActiveSystemPages> active_system_pages_after_sweeping;
-  if (should_reduce_memory_) {
+  if (discard_unused_memory) {
     // Only decrement counter when we discard unused system pages.
     active_system_pages_after_sweeping = ActiveSystemPages();
     active_system_pages_after_sweeping->Init(
@@ -493,7 +570,8 @@ int Sweeper::RawSweep(
       max_freed_bytes =
           std::max(max_freed_bytes,
                    FreeAndProcessFreedMemory(free_start, free_end, p, space,
-                                             free_space_treatment_mode));
+                                             free_space_treatment_mode,
+                                             discard_unused_memory));
       CleanupRememberedSetEntriesForFreedMemory(
           free_start, free_end, p, record_free_ranges, &free_ranges_map,
           sweeping_mode, &invalidated_old_to_new_cleanup,
@@ -527,7 +605,8 @@ int Sweeper::RawSweep(
     max_freed_bytes =
         std::max(max_freed_bytes,
                  FreeAndProcessFreedMemory(free_start, free_end, p, space,
-                                           free_space_treatment_mode));
+                                           free_space_treatment_mode,
+                                           discard_unused_memory));
     CleanupRememberedSetEntriesForFreedMemory(
         free_start, free_end, p, record_free_ranges, &free_ranges_map,
         sweeping_mode, &invalidated_old_to_new_cleanup,
@@ -741,6 +820,11 @@ GCTracer::Scope::ScopeId Sweeper::GetTracingScopeForCompleteYoungSweep() {
              : GCTracer::Scope::MC_COMPLETE_SWEEPING;
 }
 
+bool Sweeper::HasPendingPagesForSpace(AllocationSpace space) {
+  base::MutexGuard guard(&mutex_);
+  return !sweeping_list_[GetSweepSpaceIndex(space)].empty();
+}
+
 bool Sweeper::IsSweepingDoneForSpace(AllocationSpace space) {
   DCHECK(!AreSweeperTasksRunning());
   return sweeping_list_[GetSweepSpaceIndex(space)].empty();
@@ -110,12 +110,23 @@ class Sweeper {
   void EnsureCompleted();
   void PauseAndEnsureNewSpaceCompleted();
   void DrainSweepingWorklistForSpace(AllocationSpace space);
+  // Sweeps pages on the main thread until |deadline_in_ms| is reached. Returns
+  // true if no pages are left to sweep.
+  bool SweepUntilDeadline(double deadline_in_ms);
+  // Returns the free memory of pages to the operating system from now on,
+  // including the free memory of already swept old and code space pages.
+  // Called on memory pressure. Returns the number of discarded bytes.
+  size_t ReduceMemoryOnMemoryPressure();
   bool AreSweeperTasksRunning();
 
   Page* GetSweptPageSafe(PagedSpaceBase* space);
 
   bool IsSweepingDoneForSpace(AllocationSpace space);
 
+  // Returns true if pages of |space| are left that have not yet been picked
+  // up for sweeping. Can be called while sweeper tasks are running.
+  bool HasPendingPagesForSpace(AllocationSpace space);
+
   GCTracer::Scope::ScopeId GetTracingScope(AllocationSpace space,
                                            bool is_joining_thread);
   GCTracer::Scope::ScopeId GetTracingScopeForCompleteYoungSweep();
@@ -148,7 +159,12 @@ class Sweeper {
   // the operating system.
   size_t FreeAndProcessFreedMemory(
       Address free_start, Address free_end, Page* page, Space* space,
-      FreeSpaceTreatmentMode free_space_treatment_mode);
+      FreeSpaceTreatmentMode free_space_treatment_mode,
+      bool discard_unused_memory);
+
+  // Discards the system pages that are fully covered by free list entries of
+  // the already swept pages of |space|. Returns the number of discarded bytes.
+  size_t DiscardUnusedMemoryOfSweptPages(PagedSpaceBase* space);
 
   // Helper function for RawSweep. Handle remembered set entries in the freed
   // memory which require clearing.
@@ -206,7 +222,9 @@ class Sweeper {
   // Main thread can finalize sweeping, while background threads allocation slow
   // path checks this flag to see whether it could support concurrent sweeping.
   std::atomic<bool> sweeping_in_progress_;
-  bool should_reduce_memory_;
+  // Set for GCs that reduce memory and on memory pressure. Read by background
+  // threads once per page.
+  std::atomic<bool> should_reduce_memory_;
   bool should_sweep_non_new_spaces_ = false;
   PretenuringHandler* const pretenuring_handler_;
   PretenuringHandler::PretenuringFeedbackMap local_pretenuring_feedback_;
@@ -32,6 +32,9 @@ namespace internal {
   HR(gc_scavenger_scavenge_main, V8.GCScavenger.ScavengeMain, 0, 10000, 101)   \
   HR(gc_scavenger_scavenge_roots, V8.GCScavenger.ScavengeRoots, 0, 10000, 101) \
   HR(gc_marking_sum, V8.GCMarkingSum, 0, 10000, 101)                           \
+  HR(gc_pause_prediction_ratio, V8.GCPausePredictionRatio, 0, 400, 41)         \
+  HR(gc_object_age_at_death, V8.GCObjectAgeAtDeath, 0, 8, 9)                   \
+  HR(gc_object_age_at_promotion, V8.GCObjectAgeAtPromotion, 0, 8, 9)           \
   /* Asm/Wasm. */                                                              \
   HR(wasm_functions_per_asm_module, V8.WasmFunctionsPerModule.asm, 1, 1000000, \
      51)                                                                       \
@@ -453,6 +453,12 @@ class SharedFunctionInfo
 
   DECL_BOOLEAN_ACCESSORS(sparkplug_compiled)
 
+  // Set when Turbofan code is produced for this function, and cleared when
+  // that code is deoptimized. The code cache persists it, so that functions
+  // which were stably optimized in the run that produced the cache are tiered
+  // up early (see --code-cache-tiering-hints).
+  DECL_BOOLEAN_ACCESSORS(turbofan_tier_up_hint)
+
   // Is this function a top-level function (scripts, evals).
   DECL_BOOLEAN_ACCESSORS(is_toplevel)
 
@@ -8,6 +8,7 @@
 
 #include "src/base/atomicops.h"
 #include "src/base/macros.h"
+#include "src/base/platform/yield-processor.h"
 #include "src/common/assert-scope.h"
 #include "src/common/globals.h"
 #include "src/common/ptr-compr-inl.h"
@@ -88,6 +89,10 @@ bool KeyIsMatch(IsolateT* isolate, StringTableKey* key, String string) {
 // The elements themselves are stored as an open-addressed hash table, with
 // quadratic probing and Smi 0 and Smi 1 as the empty and deleted sentinels,
 // respectively.
+//
+// Lock-free writers only ever turn empty entries into strings. Outside of GC,
+// entries never become empty again, so all writers of a key agree on the first
+// empty entry of its probe sequence and at most one of them can claim it.
 class StringTable::Data {
  public:
   static std::unique_ptr<Data> New(int capacity);
@@ -107,23 +112,23 @@ class StringTable::Data {
   }
 
   void ElementAdded() {
-    DCHECK_LT(number_of_elements_ + 1, capacity());
+    DCHECK_LT(number_of_elements() + 1, capacity());
     DCHECK(StringTableHasSufficientCapacityToAdd(
         capacity(), number_of_elements(), number_of_deleted_elements(), 1));
 
-    number_of_elements_++;
+    number_of_elements_.fetch_add(1, std::memory_order_relaxed);
   }
   void DeletedElementOverwritten() {
-    DCHECK_LT(number_of_elements_ + 1, capacity());
+    DCHECK_LT(number_of_elements() + 1, capacity());
     DCHECK(StringTableHasSufficientCapacityToAdd(
         capacity(), number_of_elements(), number_of_deleted_elements() - 1, 1));
 
-    number_of_elements_++;
+    number_of_elements_.fetch_add(1, std::memory_order_relaxed);
     number_of_deleted_elements_--;
   }
   void ElementsRemoved(int count) {
-    DCHECK_LE(count, number_of_elements_);
-    number_of_elements_ -= count;
+    DCHECK_LE(count, number_of_elements());
+    number_of_elements_.fetch_sub(count, std::memory_order_relaxed);
     number_of_deleted_elements_ += count;
   }
 
@@ -132,7 +137,9 @@ class StringTable::Data {
   void operator delete(void* description);
 
   int capacity() const { return capacity_; }
-  int number_of_elements() const { return number_of_elements_; }
+  int number_of_elements() const {
+    return number_of_elements_.load(std::memory_order_relaxed);
+  }
   int number_of_deleted_elements() const { return number_of_deleted_elements_; }
 
   template <typename IsolateT, typename StringTableKey>
@@ -147,6 +154,13 @@ class StringTable::Data {
                                           StringTableKey* key,
                                           uint32_t hash) const;
 
+  // Adds the key by claiming an empty entry with a compare-and-swap, or returns
+  // the matching string if another writer added it first. Returns an empty
+  // handle if the table would have to be resized. Deleted entries are not
+  // reused.
+  template <typename IsolateT, typename StringTableKey>
+  MaybeHandle<String> TryAddLockFree(IsolateT* isolate, StringTableKey* key);
+
   // Helper method for StringTable::TryStringToIndexOrLookupExisting.
   template <typename Char>
   static Address TryStringToIndexOrLookupExisting(Isolate* isolate,
@@ -174,9 +188,15 @@ class StringTable::Data {
     return InternalIndex((last.as_uint32() + number) & (size - 1));
   }
 
+  // Counts an element that is about to be added lock-free, unless that would
+  // require the table to grow or shrink.
+  bool TryReserveElement();
+
  private:
   std::unique_ptr<Data> previous_data_;
-  int number_of_elements_;
+  // Updated by lock-free writers. The other fields only change while lock-free
+  // writers are excluded.
+  std::atomic<int> number_of_elements_;
   int number_of_deleted_elements_;
   const int capacity_;
   Tagged_t elements_[1];
@@ -243,7 +263,8 @@ std::unique_ptr<StringTable::Data> StringTable::Data::Resize(
         new_data->FindInsertionEntry(cage_base, hash);
     new_data->Set(insertion_index, string);
   }
-  new_data->number_of_elements_ = data->number_of_elements();
+  new_data->number_of_elements_.store(data->number_of_elements(),
+                                      std::memory_order_relaxed);
 
   new_data->previous_data_ = std::move(data);
   return new_data;
@@ -310,6 +331,49 @@ InternalIndex StringTable::Data::FindEntryOrInsertionEntry(
   }
 }
 
+bool StringTable::Data::TryReserveElement() {
+  int current_nof = number_of_elements();
+  do {
+    if (!StringTableHasSufficientCapacityToAdd(
+            capacity_, current_nof, number_of_deleted_elements_, 1) ||
+        ComputeStringTableCapacityWithShrink(capacity_, current_nof + 1) <
+            capacity_) {
+      return false;
+    }
+  } while (!number_of_elements_.compare_exchange_weak(
+      current_nof, current_nof + 1, std::memory_order_relaxed));
+  return true;
+}
+
+template <typename IsolateT, typename StringTableKey>
+MaybeHandle<String> StringTable::Data::TryAddLockFree(IsolateT* isolate,
+                                                      StringTableKey* key) {
+  DCHECK(!key->needs_exclusive_insertion());
+  if (!TryReserveElement()) return {};
+  // The string is a fresh copy, so it can be discarded if another writer wins.
+  Handle<String> new_string = key->GetHandleForInsertion();
+  DCHECK_IMPLIES(v8_flags.shared_string_table, new_string->IsShared());
+  uint32_t count = 1;
+  // The reservation guarantees that there are empty entries left.
+  for (InternalIndex entry = FirstProbe(key->hash(), capacity_);;
+       entry = NextProbe(entry, count++, capacity_)) {
+    Object element = Get(isolate, entry);
+    if (element == empty_element()) {
+      slot(entry).Release_CompareAndSwap(empty_element(), *new_string);
+      // Either we claimed the entry or another writer filled it first, in
+      // which case it may hold the same key.
+      element = Get(isolate, entry);
+      if (element == *new_string) return new_string;
+    }
+    if (element == deleted_element()) continue;
+    String string = String::cast(element);
+    if (KeyIsMatch(isolate, key, string)) {
+      number_of_elements_.fetch_sub(1, std::memory_order_relaxed);
+      return handle(string, isolate);
+    }
+  }
+}
+
 void StringTable::Data::IterateElements(RootVisitor* visitor) {
   OffHeapObjectSlot first_slot = slot(InternalIndex(0));
   OffHeapObjectSlot end_slot = slot(InternalIndex(capacity_));
@@ -335,12 +399,32 @@ int StringTable::Capacity() const {
   return data_.load(std::memory_order_acquire)->capacity();
 }
 int StringTable::NumberOfElements() const {
-  {
-    base::MutexGuard table_write_guard(&write_mutex_);
-    return data_.load(std::memory_order_relaxed)->number_of_elements();
-  }
+  return data_.load(std::memory_order_acquire)->number_of_elements();
 }
 
+// Excludes lock-free writers while the write mutex is held, so that entries can
+// be reused and the table can be resized. Waits for lock-free writers that are
+// already running; they never block or allocate while adding an entry.
+class V8_NODISCARD StringTable::ExclusiveWriteScope final {
+ public:
+  explicit ExclusiveWriteScope(StringTable* table) : table_(table) {
+    table_->write_mutex_.AssertHeld();
+    table_->lock_free_writers_.fetch_or(kExclusiveWriterBit,
+                                        std::memory_order_relaxed);
+    while (table_->lock_free_writers_.load(std::memory_order_acquire) !=
+           kExclusiveWriterBit) {
+      YIELD_PROCESSOR;
+    }
+  }
+  ~ExclusiveWriteScope() {
+    table_->lock_free_writers_.fetch_and(~kExclusiveWriterBit,
+                                         std::memory_order_release);
+  }
+
+ private:
+  StringTable* const table_;
+};
+
 // InternalizedStringKey carries a string/internalized-string object as key.
 class InternalizedStringKey final : public StringTableKey {
  public:
@@ -370,6 +454,7 @@ class InternalizedStringKey final : public StringTableKey {
       case StringTransitionStrategy::kInPlace:
         // In-place transition will be done in GetHandleForInsertion, when we
         // are sure that we are going to insert the string into the table.
+        set_needs_exclusive_insertion();
         return;
       case StringTransitionStrategy::kAlreadyTransitioned:
         // We can see already internalized strings here only when sharing the
@@ -549,8 +634,9 @@ Handle<String> StringTable::LookupKey(IsolateT* isolate, StringTableKey* key) {
   //
   //   - The Heap access is allowed to be concurrent (using LocalHeap or
   //     similar),
-  //   - All writes to the string table are guarded by the Isolate string table
-  //     mutex,
+  //   - All writes to the string table either claim an empty entry with a
+  //     compare-and-swap, or are guarded by the Isolate string table mutex
+  //     with lock-free writers excluded,
   //   - Resizes of the string table first copies the old contents to the new
   //     table, and only then sets the new string table pointer to the new
   //     table,
@@ -568,9 +654,11 @@ Handle<String> StringTable::LookupKey(IsolateT* isolate, StringTableKey* key) {
   // equality.
   //
   // We therefore try to optimistically read from the string table without
-  // taking the lock (both here and in the NoAllocate version of the lookup),
-  // and on a miss we take the lock and try to write the entry, with a second
-  // read lookup in case the non-locked read missed a write.
+  // taking the lock (both here and in the NoAllocate version of the lookup).
+  // On a miss, keys that were copied for insertion are added lock-free (see
+  // StringTable::Data). Otherwise, or if the table needs to be resized, we
+  // take the lock and try to write the entry, with a second read lookup in
+  // case the non-locked read missed a write.
   //
   // One complication is allocation -- we don't want to allocate while holding
   // the string table lock. This applies to both allocation of new strings, and
@@ -598,8 +686,14 @@ Handle<String> StringTable::LookupKey(IsolateT* isolate, StringTableKey* key) {
 
   // No entry found, so adding new string.
   key->PrepareForInsertion(isolate);
+  if (v8_flags.lock_free_string_table_insertion &&
+      !key->needs_exclusive_insertion()) {
+    Handle<String> result;
+    if (TryAddLockFree(isolate, key).ToHandle(&result)) return result;
+  }
   {
     base::MutexGuard table_write_guard(&write_mutex_);
+    ExclusiveWriteScope exclusive_write_scope(this);
 
     Data* data = EnsureCapacity(isolate, 1);
 
@@ -650,10 +744,28 @@ template Handle<String> StringTable::LookupKey(Isolate* isolate,
 template Handle<String> StringTable::LookupKey(LocalIsolate* isolate,
                                                StringTableInsertionKey* key);
 
+template <typename IsolateT, typename StringTableKey>
+MaybeHandle<String> StringTable::TryAddLockFree(IsolateT* isolate,
+                                                StringTableKey* key) {
+  uint32_t writers =
+      lock_free_writers_.fetch_add(1, std::memory_order_acquire);
+  MaybeHandle<String> result;
+  if (!(writers & kExclusiveWriterBit)) {
+    // Exclusive writers wait for us before resizing, so the data stays valid.
+    Data* data = data_.load(std::memory_order_acquire);
+    result = data->TryAddLockFree(isolate, key);
+  }
+  lock_free_writers_.fetch_sub(1, std::memory_order_release);
+  return result;
+}
+
 StringTable::Data* StringTable::EnsureCapacity(PtrComprCageBase cage_base,
                                                int additional_elements) {
-  // This call is only allowed while the write mutex is held.
+  // This call is only allowed while the write mutex is held and lock-free
+  // writers are excluded.
   write_mutex_.AssertHeld();
+  DCHECK_EQ(kExclusiveWriterBit,
+            lock_free_writers_.load(std::memory_order_relaxed));
 
   // This load can be relaxed as the table pointer can only be modified while
   // the lock is held.
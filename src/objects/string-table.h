@@ -30,18 +30,27 @@ class StringTableKey {
   inline uint32_t hash() const;
   int length() const { return length_; }
 
+  // Whether inserting the key has side effects that must only happen when the
+  // key is actually added, e.g. an in-place map transition. Such keys are
+  // never added lock-free.
+  bool needs_exclusive_insertion() const { return needs_exclusive_insertion_; }
+
  protected:
   inline void set_raw_hash_field(uint32_t raw_hash_field);
+  void set_needs_exclusive_insertion() { needs_exclusive_insertion_ = true; }
 
  private:
   uint32_t raw_hash_field_ = 0;
   int length_;
+  bool needs_exclusive_insertion_ = false;
 };
 
 class SeqOneByteString;
 
 // StringTable, for internalizing strings. The Lookup methods are designed to be
-// thread-safe, in combination with GC safepoints.
+// thread-safe, in combination with GC safepoints. Strings that were copied for
+// insertion are added lock-free; everything else, including resizes, happens
+// under the write mutex with lock-free writers excluded.
 //
 // The string table layout is defined by its Data implementation class, see
 // StringTable::Data for details.
@@ -75,8 +84,8 @@ class V8_EXPORT_PRIVATE StringTable {
   void Print(PtrComprCageBase cage_base) const;
   size_t GetCurrentMemoryUsage() const;
 
-  // The following methods must be called either while holding the write lock,
-  // or while in a Heap safepoint.
+  // The following methods must be called while in a Heap safepoint. Holding
+  // the write lock does not exclude lock-free writers.
   void IterateElements(RootVisitor* visitor);
   void DropOldData();
   void NotifyElementsRemoved(int count);
@@ -85,13 +94,22 @@ class V8_EXPORT_PRIVATE StringTable {
 
  private:
   class Data;
+  class ExclusiveWriteScope;
+
+  // Set in |lock_free_writers_| while a writer holds the write mutex and
+  // expects no lock-free writers.
+  static constexpr uint32_t kExclusiveWriterBit = uint32_t{1} << 31;
+
+  template <typename IsolateT, typename StringTableKey>
+  MaybeHandle<String> TryAddLockFree(IsolateT* isolate, StringTableKey* key);
 
   Data* EnsureCapacity(PtrComprCageBase cage_base, int additional_elements);
 
   std::atomic<Data*> data_;
-  // Write mutex is mutable so that readers of concurrently mutated values (e.g.
-  // NumberOfElements) are allowed to lock it while staying const.
-  mutable base::Mutex write_mutex_;
+  base::Mutex write_mutex_;
+  // Number of writers currently adding entries without holding the write
+  // mutex, combined with kExclusiveWriterBit.
+  std::atomic<uint32_t> lock_free_writers_{0};
   Isolate* isolate_;
 };
 
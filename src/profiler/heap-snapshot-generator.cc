@@ -328,7 +328,7 @@ void HeapEntry::Print(const char* prefix, const char* edge_name, int max_depth,
   }
   if (--max_depth == 0) return;
   for (auto i = children_begin(); i != children_end(); ++i) {
-    HeapGraphEdge& edge = **i;
+    HeapGraphEdge& edge = *i;
     const char* edge_prefix = "";
     base::EmbeddedVector<char, 64> index;
     edge_name = index.begin();
@@ -465,16 +465,28 @@ HeapEntry* HeapSnapshot::AddEntry(HeapEntry::Type type,
 }
 
 void HeapSnapshot::FillChildren() {
-  DCHECK(children().empty());
+  DCHECK(!is_complete());
   int children_index = 0;
   for (HeapEntry& entry : entries()) {
     children_index = entry.set_children_index(children_index);
   }
   DCHECK_EQ(edges().size(), static_cast<size_t>(children_index));
-  children().resize(edges().size());
+  // Group the edges by their source entry in place. Only a temporary index
+  // per edge is needed instead of a permanent pointer per edge, which matters
+  // for snapshots of large heaps.
+  std::vector<uint32_t> destinations;
+  destinations.reserve(edges().size());
   for (HeapGraphEdge& edge : edges()) {
-    edge.from()->add_child(&edge);
+    destinations.push_back(edge.from()->next_child_index());
+  }
+  for (size_t i = 0; i < destinations.size(); ++i) {
+    while (destinations[i] != i) {
+      uint32_t destination = destinations[i];
+      std::swap(edges_[i], edges_[destination]);
+      std::swap(destinations[i], destinations[destination]);
+    }
   }
+  is_complete_ = true;
 }
 
 HeapEntry* HeapSnapshot::GetEntryById(SnapshotObjectId id) {
@@ -2919,11 +2931,10 @@ void HeapSnapshotJSONSerializer::SerializeEdge(HeapGraphEdge* edge,
 }
 
 void HeapSnapshotJSONSerializer::SerializeEdges() {
-  std::vector<HeapGraphEdge*>& edges = snapshot_->children();
+  std::deque<HeapGraphEdge>& edges = snapshot_->edges();
   for (size_t i = 0; i < edges.size(); ++i) {
-    DCHECK(i == 0 ||
-           edges[i - 1]->from()->index() <= edges[i]->from()->index());
-    SerializeEdge(edges[i], i == 0);
+    DCHECK(i == 0 || edges[i - 1].from()->index() <= edges[i].from()->index());
+    SerializeEdge(&edges[i], i == 0);
     if (writer_->aborted()) return;
   }
 }
@@ -137,7 +137,7 @@ class HeapEntry {
   int index() const { return index_; }
   V8_INLINE int children_count() const;
   V8_INLINE int set_children_index(int index);
-  V8_INLINE void add_child(HeapGraphEdge* edge);
+  V8_INLINE int next_child_index();
   V8_INLINE HeapGraphEdge* child(int i);
   V8_INLINE Isolate* isolate() const;
 
@@ -185,8 +185,8 @@ class HeapEntry {
                                int max_depth, int indent) const;
 
  private:
-  V8_INLINE std::vector<HeapGraphEdge*>::iterator children_begin() const;
-  V8_INLINE std::vector<HeapGraphEdge*>::iterator children_end() const;
+  V8_INLINE std::deque<HeapGraphEdge>::iterator children_begin() const;
+  V8_INLINE std::deque<HeapGraphEdge>::iterator children_end() const;
   const char* TypeAsString() const;
 
   unsigned type_: 4;
@@ -234,13 +234,12 @@ class HeapSnapshot {
   const std::deque<HeapEntry>& entries() const { return entries_; }
   std::deque<HeapGraphEdge>& edges() { return edges_; }
   const std::deque<HeapGraphEdge>& edges() const { return edges_; }
-  std::vector<HeapGraphEdge*>& children() { return children_; }
   const std::vector<SourceLocation>& locations() const { return locations_; }
   void RememberLastJSObjectId();
   SnapshotObjectId max_snapshot_js_object_id() const {
     return max_snapshot_js_object_id_;
   }
-  bool is_complete() const { return !children_.empty(); }
+  bool is_complete() const { return is_complete_; }
   bool capture_numeric_value() const {
     return numerics_mode_ ==
            v8::HeapProfiler::NumericsMode::kExposeNumericValues;
@@ -275,8 +274,10 @@ class HeapSnapshot {
   // backing storage, thus all entry pointers remain valid for the duration
   // of snapshotting.
   std::deque<HeapEntry> entries_;
+  // After |FillChildren| the edges are grouped by their source entry, in the
+  // order of |entries_|, so that an entry's children form a contiguous range.
   std::deque<HeapGraphEdge> edges_;
-  std::vector<HeapGraphEdge*> children_;
+  bool is_complete_ = false;
   std::unordered_map<SnapshotObjectId, HeapEntry*> entries_by_id_cache_;
   std::vector<SourceLocation> locations_;
   SnapshotObjectId max_snapshot_js_object_id_ = -1;
@@ -401,6 +401,12 @@ RUNTIME_FUNCTION(Runtime_NotifyDeoptimized) {
     return ReadOnlyRoots(isolate).undefined_value();
   }
 
+  // The feedback the code was specialized on didn't hold, so don't recommend
+  // tiering up this function early to the isolates using the code cache.
+  if (V8_UNLIKELY(v8_flags.code_cache_tiering_hints)) {
+    function->shared().set_turbofan_tier_up_hint(false);
+  }
+
   // Non-OSR'd code is deoptimized unconditionally. If the deoptimization occurs
   // inside the outermost loop containning a loop that can trigger OSR
   // compilation, we remove the OSR code, it will avoid hit the out of date OSR
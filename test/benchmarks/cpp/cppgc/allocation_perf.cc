@@ -48,6 +48,24 @@ BENCHMARK_F(Allocate, Large)(benchmark::State& st) {
   st.SetBytesProcessed(st.iterations() * sizeof(LargeObject));
 }
 
+// Multi-threaded variants. Heaps are bound to a thread, so every benchmark
+// thread allocates on its own heap. This measures the paths that are shared
+// between threads, i.e., page allocation from the platform.
+template <typename T>
+void AllocateOnThreadLocalHeap(benchmark::State& st) {
+  std::unique_ptr<cppgc::Heap> heap = testing::BenchmarkWithHeap::CreateHeap();
+  subtle::NoGarbageCollectionScope no_gc(*Heap::From(heap.get()));
+  for (auto _ : st) {
+    USE(_);
+    benchmark::DoNotOptimize(
+        cppgc::MakeGarbageCollected<T>(heap->GetAllocationHandle()));
+  }
+  st.SetBytesProcessed(st.iterations() * sizeof(T));
+}
+
+BENCHMARK_TEMPLATE(AllocateOnThreadLocalHeap, TinyObject)->ThreadRange(1, 8);
+BENCHMARK_TEMPLATE(AllocateOnThreadLocalHeap, LargeObject)->ThreadRange(1, 8);
+
 }  // namespace
 }  // namespace internal
 }  // namespace cppgc
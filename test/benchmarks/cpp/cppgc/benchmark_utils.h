@@ -18,11 +18,13 @@ class BenchmarkWithHeap : public benchmark::Fixture {
   static void InitializeProcess();
   static void ShutdownProcess();
 
- protected:
-  void SetUp(::benchmark::State& state) override {
-    heap_ = cppgc::Heap::Create(GetPlatform());
+  static std::unique_ptr<cppgc::Heap> CreateHeap() {
+    return cppgc::Heap::Create(GetPlatform());
   }
 
+ protected:
+  void SetUp(::benchmark::State& state) override { heap_ = CreateHeap(); }
+
   void TearDown(::benchmark::State& state) override { heap_.reset(); }
 
   cppgc::Heap& heap() const { return *heap_.get(); }
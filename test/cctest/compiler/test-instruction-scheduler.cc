@@ -50,6 +50,34 @@ class InstructionSchedulerTester {
              successors.end());
   }
 
+  void CheckRegisterPressureDelta(Instruction* instr, int general_delta,
+                                  int fp_delta) {
+    CHECK_EQ(general_delta,
+             scheduler_.RegisterPressureDelta(
+                 GetNode(instr), InstructionScheduler::kGeneralRegisters));
+    CHECK_EQ(fp_delta, scheduler_.RegisterPressureDelta(
+                           GetNode(instr), InstructionScheduler::kFPRegisters));
+  }
+
+  int general_register_pressure_limit() const {
+    return scheduler_
+        .register_pressure_limit_[InstructionScheduler::kGeneralRegisters];
+  }
+
+  InstructionOperand NewRegister() {
+    return NewRegister(InstructionSequence::DefaultRepresentation());
+  }
+  InstructionOperand NewRegister(MachineRepresentation rep) {
+    int vreg = sequence_.NextVirtualRegister();
+    sequence_.MarkAsRepresentation(rep, vreg);
+    return UnallocatedOperand(UnallocatedOperand::MUST_HAVE_REGISTER, vreg);
+  }
+
+  // Instructions of the block, in scheduled order.
+  const InstructionDeque& instructions() const {
+    return sequence_.instructions();
+  }
+
   Zone* zone() { return scope_.main_zone(); }
 
  private:
@@ -104,6 +132,85 @@ TEST(DeoptInMiddleOfBasicBlock) {
   tester.EndBlock();
 }
 
+TEST(RegisterPressureDelta) {
+  InstructionSchedulerTester tester;
+  Zone* zone = tester.zone();
+
+  tester.StartBlock();
+  InstructionOperand a = tester.NewRegister();
+  InstructionOperand b = tester.NewRegister();
+  InstructionOperand c = tester.NewRegister();
+  InstructionOperand d = tester.NewRegister(MachineRepresentation::kFloat64);
+  InstructionOperand ab[] = {a, b};
+  InstructionOperand aa[] = {a, a};
+  Instruction* def_a = Instruction::New(zone, kArchNop, 1, &a, 0, nullptr, 0,
+                                        nullptr);
+  tester.AddInstruction(def_a);
+  Instruction* def_b = Instruction::New(zone, kArchNop, 1, &b, 0, nullptr, 0,
+                                        nullptr);
+  tester.AddInstruction(def_b);
+  Instruction* use_ab =
+      Instruction::New(zone, kArchNop, 1, &c, 2, ab, 0, nullptr);
+  tester.AddInstruction(use_ab);
+  Instruction* use_a = Instruction::New(zone, kArchNop, 0, nullptr, 1, &a, 0,
+                                        nullptr);
+  tester.AddInstruction(use_a);
+  Instruction* use_aa =
+      Instruction::New(zone, kArchNop, 1, &d, 2, aa, 0, nullptr);
+  tester.AddInstruction(use_aa);
+  Instruction* ret_inst = Instruction::New(zone, kArchRet);
+  tester.AddTerminator(ret_inst);
+
+  tester.CheckInSuccessors(def_a, use_ab);
+  tester.CheckInSuccessors(def_b, use_ab);
+  tester.CheckInSuccessors(def_a, use_a);
+  // Definitions increase the number of live values.
+  tester.CheckRegisterPressureDelta(def_a, 1, 0);
+  tester.CheckRegisterPressureDelta(def_b, 1, 0);
+  // {use_ab} ends the live range of {b} but not of {a}, which is still used
+  // by {use_a} and {use_aa}.
+  tester.CheckRegisterPressureDelta(use_ab, 0, 0);
+  tester.CheckRegisterPressureDelta(use_a, 0, 0);
+  // {a} is used twice by {use_aa} but only counts as one use. The
+  // floating-point value it defines does not count against general registers.
+  tester.CheckRegisterPressureDelta(use_aa, 0, 1);
+
+  // Schedule block.
+  tester.EndBlock();
+}
+
+TEST(HighRegisterPressure) {
+  InstructionSchedulerTester tester;
+  Zone* zone = tester.zone();
+  const int limit = tester.general_register_pressure_limit();
+
+  // Define one more value than there are allocatable general registers, each
+  // with its own use. Definitions are on a longer path than uses, so they
+  // would all be scheduled first without register pressure tracking.
+  tester.StartBlock();
+  std::vector<InstructionOperand> values;
+  for (int i = 0; i <= limit; ++i) {
+    values.push_back(tester.NewRegister());
+    tester.AddInstruction(Instruction::New(zone, kArchNop, 1, &values.back(),
+                                           0, nullptr, 0, nullptr));
+  }
+  for (int i = 0; i <= limit; ++i) {
+    tester.AddInstruction(Instruction::New(zone, kArchNop, 0, nullptr, 1,
+                                           &values[i], 0, nullptr));
+  }
+  tester.AddTerminator(Instruction::New(zone, kArchRet));
+  tester.EndBlock();
+
+  // Once all registers are live, a use is picked to free one of them.
+  const InstructionDeque& instructions =
+      tester.instructions();
+  for (int i = 0; i < limit; ++i) {
+    CHECK_EQ(1, instructions[i]->OutputCount());
+  }
+  CHECK_EQ(0, instructions[limit]->OutputCount());
+  CHECK_EQ(1, instructions[limit]->InputCount());
+}
+
 }  // namespace compiler
 }  // namespace internal
 }  // namespace v8
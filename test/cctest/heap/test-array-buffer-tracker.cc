@@ -432,6 +432,43 @@ TEST(ArrayBuffer_ExternalBackingStoreSizeDecreases) {
   CHECK_EQ(0, backing_store_after - backing_store_before);
 }
 
+TEST(ArrayBuffer_ConcurrentSweepingReleasesDeadBackingStores) {
+  if (v8_flags.single_generation) return;
+  ManualGCScope manual_gc_scope;
+  v8_flags.concurrent_array_buffer_sweeping = true;
+  CcTest::InitializeVM();
+  LocalContext env;
+  v8::Isolate* isolate = env->GetIsolate();
+  Heap* heap = reinterpret_cast<Isolate*>(isolate)->heap();
+
+  const uint64_t backing_store_before = heap->backing_store_bytes();
+  const size_t kArraybufferSize = 117;
+  // More than a single release batch.
+  const size_t kNumArrayBuffers = 4 * ArrayBufferSweeper::kReleaseBatchSize;
+  std::vector<std::weak_ptr<v8::BackingStore>> backing_stores;
+  {
+    v8::HandleScope handle_scope(isolate);
+    for (size_t i = 0; i < kNumArrayBuffers; i++) {
+      Local<v8::ArrayBuffer> ab =
+          v8::ArrayBuffer::New(isolate, kArraybufferSize);
+      backing_stores.push_back(ab->GetBackingStore());
+    }
+  }
+  CHECK_EQ(kNumArrayBuffers * kArraybufferSize,
+           heap->backing_store_bytes() - backing_store_before);
+  CcTest::CollectAllGarbage();
+  // Dead backing stores are accounted for as soon as sweeping finishes, even
+  // if they are still waiting in the release queue.
+  heap->array_buffer_sweeper()->EnsureFinished();
+  CHECK_EQ(backing_store_before, heap->backing_store_bytes());
+  // Once the release queue is drained, the extensions of the dead buffers
+  // dropped the last references to their backing stores.
+  heap->array_buffer_sweeper()->WaitForReleaseTasks();
+  for (const std::weak_ptr<v8::BackingStore>& backing_store : backing_stores) {
+    CHECK(backing_store.expired());
+  }
+}
+
 TEST(ArrayBuffer_ExternalBackingStoreSizeIncreasesMarkCompact) {
   if (!v8_flags.compact) return;
   ManualGCScope manual_gc_scope;
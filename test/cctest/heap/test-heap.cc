@@ -1330,6 +1330,43 @@ UNINITIALIZED_TEST(Regress10843) {
   isolate->Dispose();
 }
 
+UNINITIALIZED_TEST(BufferedMarkingBarrier) {
+  if (!v8_flags.incremental_marking || v8_flags.single_generation) return;
+  ManualGCScope manual_gc_scope;
+  v8_flags.buffered_marking_barrier = true;
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  v8::Isolate* isolate = v8::Isolate::New(create_params);
+  Isolate* i_isolate = reinterpret_cast<Isolate*>(isolate);
+  {
+    v8::Isolate::Scope isolate_scope(isolate);
+    HandleScope scope(i_isolate);
+    Heap* heap = i_isolate->heap();
+    Factory* factory = i_isolate->factory();
+    Handle<FixedArray> host = factory->NewFixedArray(1, AllocationType::kOld);
+    heap::SimulateIncrementalMarking(heap, false);
+
+    // Young objects are allocated white during marking.
+    Handle<FixedArray> value = factory->NewFixedArray(1);
+    MarkingState* marking_state = heap->marking_state();
+    CHECK(marking_state->IsWhite(*value));
+
+    // The write is recorded in the buffer and marked when it is flushed.
+    host->set(0, *value);
+    CHECK(marking_state->IsWhite(*value));
+    heap->main_thread_local_heap()->marking_barrier()->FlushBuffer();
+    CHECK(!marking_state->IsWhite(*value));
+
+    // Buffered values are flushed before objects move.
+    Handle<FixedArray> other_value = factory->NewFixedArray(1);
+    host->set(0, *other_value);
+    heap->CollectAllGarbage(Heap::kNoGCFlags,
+                            GarbageCollectionReason::kTesting);
+    CHECK_EQ(host->get(0), *other_value);
+  }
+  isolate->Dispose();
+}
+
 size_t near_heap_limit_invocation_count = 0;
 size_t InvokeGCNearHeapLimitCallback(void* data, size_t current_heap_limit,
                                      size_t initial_heap_limit) {
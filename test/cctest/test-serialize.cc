@@ -2717,6 +2717,56 @@ TEST(CodeSerializerAfterExecute) {
   v8_flags.always_turbofan = prev_always_turbofan_value;
 }
 
+TEST(CodeSerializerTurbofanTierUpHint) {
+  if (!v8_flags.turbofan || v8_flags.always_turbofan) return;
+  v8_flags.allow_natives_syntax = true;
+  v8_flags.code_cache_tiering_hints = true;
+  FlagList::EnforceFlagImplications();
+  const char* js_source =
+      "function f(x) { return x + 1; };"
+      "function g(x) { return x - 1; };"
+      "%PrepareFunctionForOptimization(f);"
+      "f(1);"
+      "%OptimizeFunctionOnNextCall(f);"
+      "f(2);"
+      "g(1);"
+      "'abc' + 'def'";
+  v8::ScriptCompiler::CachedData* cache =
+      CompileRunAndProduceCache(js_source, CodeCacheType::kAfterExecute);
+
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  v8::Isolate* isolate2 = v8::Isolate::New(create_params);
+  {
+    v8::Isolate::Scope iscope(isolate2);
+    v8::HandleScope scope(isolate2);
+    v8::Local<v8::Context> context = v8::Context::New(isolate2);
+    v8::Context::Scope context_scope(context);
+
+    v8::Local<v8::String> source_str = v8_str(js_source);
+    v8::ScriptOrigin origin(isolate2, v8_str("test"));
+    v8::ScriptCompiler::Source source(source_str, origin, cache);
+    v8::Local<v8::UnboundScript> script =
+        v8::ScriptCompiler::CompileUnboundScript(
+            isolate2, &source, v8::ScriptCompiler::kConsumeCodeCache)
+            .ToLocalChecked();
+    CHECK(!cache->rejected);
+
+    // Only the function that was optimized in the first isolate got the hint.
+    Handle<SharedFunctionInfo> toplevel = v8::Utils::OpenHandle(*script);
+    SharedFunctionInfo::ScriptIterator iter(
+        reinterpret_cast<Isolate*>(isolate2),
+        Script::cast(toplevel->script()));
+    for (SharedFunctionInfo info = iter.Next(); !info.is_null();
+         info = iter.Next()) {
+      if (info.is_toplevel()) continue;
+      CHECK_EQ(info.turbofan_tier_up_hint(),
+               strcmp(info.DebugNameCStr().get(), "f") == 0);
+    }
+  }
+  isolate2->Dispose();
+}
+
 TEST(CodeSerializerFlagChange) {
   const char* js_source = "function f() { return 'abc'; }; f() + 'def'";
   v8::ScriptCompiler::CachedData* cache = CompileRunAndProduceCache(js_source);
@@ -515,6 +515,94 @@ UNINITIALIZED_TEST(ConcurrentStringTableLookup) {
   }
 }
 
+class ConcurrentCopyingInternalizationThread final
+    : public ConcurrentStringThreadBase {
+ public:
+  ConcurrentCopyingInternalizationThread(
+      MultiClientIsolateTest* test, Handle<FixedArray> shared_strings,
+      Handle<FixedArray> results, int results_offset,
+      ParkingSemaphore* sema_ready, ParkingSemaphore* sema_execute_start,
+      ParkingSemaphore* sema_execute_complete)
+      : ConcurrentStringThreadBase("ConcurrentCopyingInternalization", test,
+                                   shared_strings, sema_ready,
+                                   sema_execute_start, sema_execute_complete),
+        results_(results),
+        results_offset_(results_offset) {}
+
+  void RunForString(Handle<String> input_string, int counter) override {
+    // Internalizing from characters always inserts a fresh copy, which takes
+    // the lock-free path on misses.
+    std::unique_ptr<char[]> chars = input_string->ToCString();
+    Handle<String> interned =
+        i_isolate->factory()->InternalizeString(base::CStrVector(chars.get()));
+    CHECK(interned->IsShared());
+    CHECK(interned->IsInternalizedString());
+    results_->set(results_offset_ + counter, *interned);
+  }
+
+ private:
+  Handle<FixedArray> results_;
+  int results_offset_;
+};
+
+UNINITIALIZED_TEST(ConcurrentCopyingInternalization) {
+  if (!V8_CAN_CREATE_SHARED_HEAP_BOOL) return;
+
+  v8_flags.shared_string_table = true;
+
+  constexpr int kThreads = 8;
+  constexpr int kStrings = 4096;
+
+  MultiClientIsolateTest test;
+  Isolate* i_isolate = test.i_main_isolate();
+  Factory* factory = i_isolate->factory();
+
+  HandleScope scope(i_isolate);
+
+  Handle<FixedArray> shared_strings =
+      CreateSharedOneByteStrings(i_isolate, factory, kStrings, 2, false);
+  Handle<FixedArray> results =
+      factory->NewFixedArray(kThreads * kStrings, AllocationType::kSharedOld);
+
+  ParkingSemaphore sema_ready(0);
+  ParkingSemaphore sema_execute_start(0);
+  ParkingSemaphore sema_execute_complete(0);
+  std::vector<std::unique_ptr<ConcurrentCopyingInternalizationThread>> threads;
+  for (int i = 0; i < kThreads; i++) {
+    auto thread = std::make_unique<ConcurrentCopyingInternalizationThread>(
+        &test, shared_strings, results, i * kStrings, &sema_ready,
+        &sema_execute_start, &sema_execute_complete);
+    CHECK(thread->Start());
+    threads.push_back(std::move(thread));
+  }
+
+  LocalIsolate* local_isolate = i_isolate->main_thread_local_isolate();
+  for (int i = 0; i < kThreads; i++) {
+    sema_ready.ParkedWait(local_isolate);
+  }
+  for (int i = 0; i < kThreads; i++) {
+    sema_execute_start.Signal();
+  }
+  for (int i = 0; i < kThreads; i++) {
+    sema_execute_complete.ParkedWait(local_isolate);
+  }
+
+  {
+    ParkedScope parked(local_isolate);
+    for (auto& thread : threads) {
+      thread->ParkedJoin(parked);
+    }
+  }
+
+  // All threads must have ended up with the same internalized string.
+  for (int i = 0; i < kStrings; i++) {
+    Object expected = results->get(i);
+    for (int j = 1; j < kThreads; j++) {
+      CHECK_EQ(expected, results->get(j * kStrings + i));
+    }
+  }
+}
+
 namespace {
 
 void CheckSharedStringIsEqualCopy(Handle<String> shared,
@@ -0,0 +1,125 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Scalar kernels whose basic blocks contain independent chains of arithmetic
+// instructions with long latencies, which the instruction scheduler can
+// interleave.
+
+const kLength = 1024;
+const kRounds = 20;
+
+new BenchmarkSuite('DotProduct', [1000], [
+  new Benchmark('DotProduct', false, false, 0, DotProduct, ScalarSetup,
+                ScalarTearDown)
+]);
+
+new BenchmarkSuite('MatMul4x4', [1000], [
+  new Benchmark('MatMul4x4', false, false, 0, MatMul4x4, ScalarSetup,
+                ScalarTearDown)
+]);
+
+new BenchmarkSuite('Hash', [1000], [
+  new Benchmark('Hash', false, false, 0, Hash, ScalarSetup, ScalarTearDown)
+]);
+
+new BenchmarkSuite('Polynomial', [1000], [
+  new Benchmark('Polynomial', false, false, 0, Polynomial, ScalarSetup,
+                ScalarTearDown)
+]);
+
+let a;
+let b;
+let ints;
+let result;
+
+function ScalarSetup() {
+  a = new Float64Array(kLength);
+  b = new Float64Array(kLength);
+  ints = new Int32Array(kLength);
+  for (let i = 0; i < kLength; i++) {
+    a[i] = (i % 17) * 0.25;
+    b[i] = 1 / (1 + (i % 13));
+    ints[i] = i * 0x9e3779b1;
+  }
+}
+
+function ScalarTearDown() {
+  a = null;
+  b = null;
+  ints = null;
+  if (!Number.isFinite(result)) {
+    throw new Error(`Unexpected result: ${result}`);
+  }
+}
+
+// Four independent accumulators.
+function DotProduct() {
+  let s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+  for (let round = 0; round < kRounds; round++) {
+    for (let i = 0; i < kLength; i += 4) {
+      s0 += a[i] * b[i];
+      s1 += a[i + 1] * b[i + 1];
+      s2 += a[i + 2] * b[i + 2];
+      s3 += a[i + 3] * b[i + 3];
+    }
+  }
+  result = s0 + s1 + s2 + s3;
+}
+
+// Fully unrolled product of 4x4 matrices stored in {a}.
+function MatMul4x4() {
+  let checksum = 0;
+  for (let round = 0; round < kRounds; round++) {
+    for (let m = 0; m + 32 <= kLength; m += 32) {
+      const x = m, y = m + 16;
+      for (let r = 0; r < 16; r += 4) {
+        const x0 = a[x + r], x1 = a[x + r + 1];
+        const x2 = a[x + r + 2], x3 = a[x + r + 3];
+        b[m + r] = x0 * a[y] + x1 * a[y + 4] + x2 * a[y + 8] + x3 * a[y + 12];
+        b[m + r + 1] =
+            x0 * a[y + 1] + x1 * a[y + 5] + x2 * a[y + 9] + x3 * a[y + 13];
+        b[m + r + 2] =
+            x0 * a[y + 2] + x1 * a[y + 6] + x2 * a[y + 10] + x3 * a[y + 14];
+        b[m + r + 3] =
+            x0 * a[y + 3] + x1 * a[y + 7] + x2 * a[y + 11] + x3 * a[y + 15];
+      }
+      checksum += b[m];
+    }
+  }
+  result = checksum;
+}
+
+// Two interleaved FNV-1a hashes of 32-bit words.
+function Hash() {
+  let h0 = 0x811c9dc5 | 0, h1 = 0x01000193 | 0;
+  for (let round = 0; round < kRounds; round++) {
+    for (let i = 0; i < kLength; i += 2) {
+      h0 = Math.imul(h0 ^ ints[i], 0x01000193);
+      h1 = Math.imul(h1 ^ ints[i + 1], 0x01000193);
+      h0 ^= h0 >>> 15;
+      h1 ^= h1 >>> 13;
+    }
+  }
+  result = (h0 ^ h1) >>> 0;
+}
+
+// Estrin's scheme for a polynomial of degree 7, with divisions.
+function Polynomial() {
+  let sum = 0;
+  for (let round = 0; round < kRounds; round++) {
+    for (let i = 0; i < kLength; i++) {
+      const x = a[i];
+      const x2 = x * x;
+      const x4 = x2 * x2;
+      const p01 = 1.5 + 0.75 * x;
+      const p23 = -0.5 + 0.125 * x;
+      const p45 = 0.0625 - 0.03125 * x;
+      const p67 = 0.015625 + 0.0078125 * x;
+      const p03 = p01 + p23 * x2;
+      const p47 = p45 + p67 * x2;
+      sum += (p03 + p47 * x4) / (1 + x2);
+    }
+  }
+  result = sum;
+}
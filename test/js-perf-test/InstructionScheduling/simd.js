@@ -0,0 +1,131 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Wasm SIMD kernels. The module is equivalent to:
+//
+// (module
+//   (memory (export "memory") 1)
+//   ;; Dot product of the {n} floats at 0 and at 4 * n.
+//   (func (export "dot") (param $n i32) (result f32)
+//     (local $i i32) (local $end i32) (local $acc v128)
+//     (local.set $end (i32.shl (local.get $n) (i32.const 2)))
+//     (loop $l
+//       (local.set $acc
+//         (f32x4.add (local.get $acc)
+//           (f32x4.mul (v128.load (local.get $i))
+//                      (v128.load (i32.add (local.get $i)
+//                                          (local.get $end))))))
+//       (br_if $l (i32.lt_u (local.tee $i (i32.add (local.get $i)
+//                                                   (i32.const 16)))
+//                           (local.get $end))))
+//     (f32.add (f32.add (f32.add (f32x4.extract_lane 0 (local.get $acc))
+//                                (f32x4.extract_lane 1 (local.get $acc)))
+//                       (f32x4.extract_lane 2 (local.get $acc)))
+//              (f32x4.extract_lane 3 (local.get $acc))))
+//   ;; c[i] += a[i] * b[i], for the {n} ints at 0, 4 * n and 8 * n.
+//   (func (export "mla") (param $n i32)
+//     (local $i i32) (local $end i32)
+//     (local.set $end (i32.shl (local.get $n) (i32.const 2)))
+//     (loop $l
+//       (v128.store (i32.add (local.get $i)
+//                            (i32.add (local.get $end) (local.get $end)))
+//         (i32x4.add
+//           (v128.load (i32.add (local.get $i)
+//                               (i32.add (local.get $end) (local.get $end))))
+//           (i32x4.mul (v128.load (local.get $i))
+//                      (v128.load (i32.add (local.get $i)
+//                                          (local.get $end))))))
+//       (br_if $l (i32.lt_u (local.tee $i (i32.add (local.get $i)
+//                                                   (i32.const 16)))
+//                           (local.get $end))))))
+const kSimdModuleBytes = new Uint8Array([
+  0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00,  // magic, version
+  // Type section: (i32) -> f32, (i32) -> ().
+  0x01, 0x0a, 0x02, 0x60, 0x01, 0x7f, 0x01, 0x7d, 0x60, 0x01, 0x7f, 0x00,
+  // Function section.
+  0x03, 0x03, 0x02, 0x00, 0x01,
+  // Memory section.
+  0x05, 0x03, 0x01, 0x00, 0x01,
+  // Export section.
+  0x07, 0x16, 0x03,
+  0x06, 0x6d, 0x65, 0x6d, 0x6f, 0x72, 0x79, 0x02, 0x00,  // "memory"
+  0x03, 0x64, 0x6f, 0x74, 0x00, 0x00,                    // "dot"
+  0x03, 0x6d, 0x6c, 0x61, 0x00, 0x01,                    // "mla"
+  // Code section.
+  0x0a, 0x96, 0x01, 0x02,
+  // dot
+  0x4c, 0x02, 0x02, 0x7f, 0x01, 0x7b,
+  0x20, 0x00, 0x41, 0x02, 0x74, 0x21, 0x02,
+  0x03, 0x40,
+  0x20, 0x03,
+  0x20, 0x01, 0xfd, 0x00, 0x04, 0x00,
+  0x20, 0x01, 0x20, 0x02, 0x6a, 0xfd, 0x00, 0x04, 0x00,
+  0xfd, 0xe6, 0x01, 0xfd, 0xe4, 0x01, 0x21, 0x03,
+  0x20, 0x01, 0x41, 0x10, 0x6a, 0x22, 0x01, 0x20, 0x02, 0x49, 0x0d, 0x00,
+  0x0b,
+  0x20, 0x03, 0xfd, 0x1f, 0x00, 0x20, 0x03, 0xfd, 0x1f, 0x01, 0x92,
+  0x20, 0x03, 0xfd, 0x1f, 0x02, 0x92, 0x20, 0x03, 0xfd, 0x1f, 0x03, 0x92,
+  0x0b,
+  // mla
+  0x47, 0x01, 0x02, 0x7f,
+  0x20, 0x00, 0x41, 0x02, 0x74, 0x21, 0x02,
+  0x03, 0x40,
+  0x20, 0x01, 0x20, 0x02, 0x20, 0x02, 0x6a, 0x6a,
+  0x20, 0x01, 0x20, 0x02, 0x20, 0x02, 0x6a, 0x6a, 0xfd, 0x00, 0x04, 0x00,
+  0x20, 0x01, 0xfd, 0x00, 0x04, 0x00,
+  0x20, 0x01, 0x20, 0x02, 0x6a, 0xfd, 0x00, 0x04, 0x00,
+  0xfd, 0xb5, 0x01, 0xfd, 0xae, 0x01, 0xfd, 0x0b, 0x04, 0x00,
+  0x20, 0x01, 0x41, 0x10, 0x6a, 0x22, 0x01, 0x20, 0x02, 0x49, 0x0d, 0x00,
+  0x0b,
+  0x0b,
+]);
+
+// Number of lanes of each array; a multiple of 4.
+const kSimdLength = 1024;
+const kSimdRounds = 20;
+
+new BenchmarkSuite('SimdDotProduct', [1000], [
+  new Benchmark('SimdDotProduct', false, false, 0, SimdDotProduct, SimdSetup,
+                SimdTearDown)
+]);
+
+new BenchmarkSuite('SimdMultiplyAdd', [1000], [
+  new Benchmark('SimdMultiplyAdd', false, false, 0, SimdMultiplyAdd,
+                SimdSetup, SimdTearDown)
+]);
+
+let simd;
+let simdResult;
+
+function SimdSetup() {
+  const instance = new WebAssembly.Instance(
+      new WebAssembly.Module(kSimdModuleBytes));
+  simd = instance.exports;
+  const floats = new Float32Array(simd.memory.buffer, 0, 2 * kSimdLength);
+  for (let i = 0; i < floats.length; i++) {
+    floats[i] = (i % 7) * 0.5;
+  }
+}
+
+function SimdTearDown() {
+  simd = null;
+  if (!Number.isFinite(simdResult)) {
+    throw new Error(`Unexpected result: ${simdResult}`);
+  }
+}
+
+function SimdDotProduct() {
+  let sum = 0;
+  for (let round = 0; round < kSimdRounds; round++) {
+    sum += simd.dot(kSimdLength);
+  }
+  simdResult = sum;
+}
+
+function SimdMultiplyAdd() {
+  for (let round = 0; round < kSimdRounds; round++) {
+    simd.mla(kSimdLength);
+  }
+  simdResult = new Int32Array(simd.memory.buffer, 8 * kSimdLength, 1)[0];
+}
@@ -0,0 +1,70 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Measures mutator throughput of pointer stores while incremental marking is
+// active. The suite is run with --stress-incremental-marking so that most
+// stores hit the marking barrier.
+
+const kArrayLength = 10000;
+const kRounds = 10;
+
+new BenchmarkSuite('StoreSameValue', [1000], [
+  new Benchmark('StoreSameValue', false, false, 0, StoreSameValue,
+                StoresSetup, StoresTearDown)
+]);
+
+new BenchmarkSuite('StoreNewValues', [1000], [
+  new Benchmark('StoreNewValues', false, false, 0, StoreNewValues,
+                StoresSetup, StoresTearDown)
+]);
+
+new BenchmarkSuite('StoreFields', [1000], [
+  new Benchmark('StoreFields', false, false, 0, StoreFields,
+                StoresSetup, StoresTearDown)
+]);
+
+let array;
+let objects;
+
+function StoresSetup() {
+  array = new Array(kArrayLength).fill(null);
+  objects = [];
+  for (let i = 0; i < kArrayLength; i++) {
+    objects.push({ value: i, next: null });
+  }
+}
+
+function StoresTearDown() {
+  array = null;
+  objects = null;
+}
+
+// Repeatedly stores the same few values.
+function StoreSameValue() {
+  const a = objects[0];
+  const b = objects[1];
+  for (let round = 0; round < kRounds; round++) {
+    for (let i = 0; i < kArrayLength; i++) {
+      array[i] = (i & 1) ? a : b;
+    }
+  }
+}
+
+// Stores freshly allocated values.
+function StoreNewValues() {
+  for (let round = 0; round < kRounds; round++) {
+    for (let i = 0; i < kArrayLength; i++) {
+      array[i] = { value: i };
+    }
+  }
+}
+
+// Relinks existing objects.
+function StoreFields() {
+  for (let round = 0; round < kRounds; round++) {
+    for (let i = 0; i < kArrayLength; i++) {
+      objects[i].next = objects[(i * 7 + round) % kArrayLength];
+    }
+  }
+}
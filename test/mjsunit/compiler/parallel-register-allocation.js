@@ -0,0 +1,53 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --turbo-parallel-register-allocation
+
+// Mixes integer and floating-point values with enough register pressure
+// (and a call clobbering all registers) to spill and split live ranges of
+// both kinds, which are then allocated concurrently.
+function Mixed(a, n, d) {
+  let i0 = 0, i1 = 1, i2 = 2, i3 = 3, i4 = 4, i5 = 5;
+  let d0 = d, d1 = d * 2, d2 = d * 3, d3 = d * 4, d4 = d * 5, d5 = d * 6;
+  for (let i = 0; i < n; i++) {
+    i0 = (i0 + a[i % a.length]) | 0;
+    i1 = (i1 ^ i0) | 0;
+    i2 = (i2 + i1 * 3) | 0;
+    i3 = (i3 - i2) | 0;
+    i4 = (i4 + (i3 >> 1)) | 0;
+    i5 = (i5 + i4) | 0;
+    d0 += i0 * 0.5;
+    d1 = d1 * 0.75 + d0;
+    d2 -= d1 / 3;
+    d3 = Math.sqrt(Math.abs(d3 + d2));
+    d4 += d3 * 1.5;
+    d5 = d5 * 0.25 + d4;
+    if (i % 7 == 0) {
+      d5 += Math.sin(d0 + i5);
+    }
+  }
+  return [i0, i1, i2, i3, i4, i5, d0, d1, d2, d3, d4, d5];
+}
+
+%PrepareFunctionForOptimization(Mixed);
+const a = [1, 2, 3, 4, 5, 6, 7, 8, 9];
+const expected = [0, 1, 10, 100].map(n => Mixed(a, n, 1.25));
+%OptimizeFunctionOnNextCall(Mixed);
+[0, 1, 10, 100].forEach(
+    (n, i) => assertEquals(expected[i], Mixed(a, n, 1.25)));
+
+// Only integer values: a single register kind, which is allocated serially.
+function IntegersOnly(n) {
+  let x = 0, y = 1;
+  for (let i = 0; i < n; i++) {
+    x = (x + y * i) | 0;
+    y = (y ^ x) | 0;
+  }
+  return x + y;
+}
+
+%PrepareFunctionForOptimization(IntegersOnly);
+const expected_int = IntegersOnly(20);
+%OptimizeFunctionOnNextCall(IntegersOnly);
+assertEquals(expected_int, IntegersOnly(20));
@@ -0,0 +1,95 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// Flags: --turboshaft --turboshaft-load-elimination --allow-natives-syntax
+
+// {inputs} are functions returning fresh arguments, since most of the tested
+// functions modify their arguments.
+function Test(f, inputs) {
+  %PrepareFunctionForOptimization(f);
+  const expected = inputs.map(args => f(...args()));
+  %OptimizeFunctionOnNextCall(f);
+  inputs.forEach((args, i) => assertEquals(expected[i], f(...args())));
+}
+
+// Redundant loads of the same field.
+function RedundantLoad(o) {
+  return o.a + o.a;
+}
+Test(RedundantLoad, [() => [{a: 1}], () => [{a: 2}]]);
+
+// A store to a field of another object could alias.
+function StoreToOtherObject(o, p) {
+  const x = o.a;
+  p.a = 42;
+  return x + o.a;
+}
+Test(StoreToOtherObject, [
+  () => [{a: 1}, {a: 2}],
+  () => {
+    const o = {a: 1};
+    return [o, o];
+  }
+]);
+
+// Store-to-load forwarding.
+function StoreThenLoad(o, v) {
+  o.a = v;
+  return o.a;
+}
+Test(StoreThenLoad, [() => [{a: 1}, 2], () => [{a: 1}, 3]]);
+
+// Element stores clobber all fields (including the length) and elements.
+function ElementStore(arr, i, j) {
+  const length = arr.length;
+  const x = arr[j];
+  arr[i] = 17;
+  return length + x + arr.length + arr[j];
+}
+Test(ElementStore, [() => [[1, 2, 3], 0, 1], () => [[1, 2, 3], 1, 1]]);
+
+// Loads that depend on a store in a loop body.
+function LoopStore(o, n) {
+  let sum = 0;
+  for (let i = 0; i < n; i++) {
+    sum += o.a;
+    o.a = i;
+  }
+  return sum + o.a;
+}
+Test(LoopStore, [() => [{a: 10}, 5], () => [{a: 20}, 0]]);
+
+// Merges keep a value only if it is the same on all paths.
+function Merge(o, c) {
+  if (c) {
+    o.a = 1;
+  } else {
+    o.a = 2;
+  }
+  return o.a;
+}
+Test(Merge, [() => [{a: 0}, true], () => [{a: 0}, false]]);
+
+// Calls clobber everything.
+function Clobber(o) {
+  o.a = 100;
+}
+%NeverOptimizeFunction(Clobber);
+function LoadAroundCall(o) {
+  const x = o.a;
+  Clobber(o);
+  return x + o.a;
+}
+Test(LoadAroundCall, [() => [{a: 1}], () => [{a: 2}]]);
+
+// Constant additions to the index are folded into the offset of element
+// accesses, which thus don't only access memory after their offset.
+function StoreToFirstElement(a, j) {
+  const x = a[j + 1];
+  a[0] = 42;
+  return x + a[j + 1];
+}
+Test(StoreToFirstElement, [
+  () => [[1, 2, 3], -1], () => [[1, 2, 3], 0], () => [[1, 2, 3], 1]
+]);
@@ -0,0 +1,80 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// Flags: --turboshaft --turboshaft-loop-peeling --turboshaft-loop-unrolling
+// Flags: --allow-natives-syntax
+
+function Test(f, inputs) {
+  %PrepareFunctionForOptimization(f);
+  const expected = inputs.map(args => f(...args));
+  %OptimizeFunctionOnNextCall(f);
+  inputs.forEach((args, i) => assertEquals(expected[i], f(...args)));
+}
+
+// Small counted loop, with a number of iterations that is or isn't a multiple
+// of the unroll count.
+function CountedLoop(n) {
+  let sum = 0;
+  for (let i = 0; i < n; i++) {
+    sum += i;
+  }
+  return sum;
+}
+Test(CountedLoop, [[0], [1], [2], [5], [7], [100], [101]]);
+
+// Decreasing induction variable.
+function DownwardLoop(n) {
+  let product = 1;
+  for (let i = n; i > 0; i -= 2) {
+    product = (product * 3 + i) | 0;
+  }
+  return product;
+}
+Test(DownwardLoop, [[0], [1], [10], [33]]);
+
+// Early exits from the body, and values of the loop used after it.
+function EarlyExit(arr, x) {
+  let i = 0;
+  for (; i < arr.length; i++) {
+    if (arr[i] === x) break;
+  }
+  return i;
+}
+Test(EarlyExit, [
+  [[], 1], [[1], 1], [[1, 2, 3, 4, 5, 6], 4], [[1, 2, 3, 4, 5, 6], 7]
+]);
+
+// Loop-invariant loads and checks, which peeling allows to hoist.
+function InvariantLoads(o, n) {
+  let sum = 0;
+  for (let i = 0; i < n; i++) {
+    sum += o.a * o.b;
+  }
+  return sum;
+}
+Test(InvariantLoads, [[{a: 2, b: 3}, 0], [{a: 2, b: 3}, 1], [{a: 1, b: 5}, 9]]);
+
+// Loops whose exit is at the end of the body.
+function DoWhile(n) {
+  let i = 0;
+  let acc = 0;
+  do {
+    acc += i * 2;
+    i++;
+  } while (i < n);
+  return acc;
+}
+Test(DoWhile, [[0], [1], [6], [13]]);
+
+// Nested loops: only the innermost one is transformed.
+function Nested(n, m) {
+  let sum = 0;
+  for (let i = 0; i < n; i++) {
+    for (let j = 0; j < m; j++) {
+      sum += i * j;
+    }
+  }
+  return sum;
+}
+Test(Nested, [[0, 3], [3, 0], [4, 5], [7, 11]]);
@@ -0,0 +1,78 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// Flags: --turboshaft-wasm --turboshaft-loop-peeling
+// Flags: --turboshaft-loop-unrolling --no-liftoff
+
+d8.file.execute("test/mjsunit/wasm/wasm-module-builder.js");
+
+(function CountedLoopTest() {
+  print(arguments.callee.name);
+  let builder = new WasmModuleBuilder();
+  // Computes the sum of the integers in [0, n).
+  builder.addFunction("sum", kSig_i_i)
+    .addLocals(kWasmI32, 2)  // i, sum
+    .addBody([
+      kExprBlock, kWasmVoid,
+        kExprLoop, kWasmVoid,
+          kExprLocalGet, 1,
+          kExprLocalGet, 0,
+          kExprI32GeS,
+          kExprBrIf, 1,
+          kExprLocalGet, 2,
+          kExprLocalGet, 1,
+          kExprI32Add,
+          kExprLocalSet, 2,
+          kExprLocalGet, 1,
+          kExprI32Const, 1,
+          kExprI32Add,
+          kExprLocalSet, 1,
+          kExprBr, 0,
+        kExprEnd,
+      kExprEnd,
+      kExprLocalGet, 2])
+    .exportFunc();
+  let instance = builder.instantiate();
+  for (let n of [0, 1, 2, 3, 4, 5, 6, 17, 100]) {
+    assertEquals(n * (n - 1) / 2, instance.exports.sum(n));
+  }
+})();
+
+(function LoopWithMemoryAccessesTest() {
+  print(arguments.callee.name);
+  let builder = new WasmModuleBuilder();
+  builder.addMemory(1, 1);
+  // Stores {i} at address {4 * i} for i in [0, n), and returns the value
+  // loaded from the last address written.
+  builder.addFunction("fill", kSig_i_i)
+    .addLocals(kWasmI32, 1)  // i
+    .addBody([
+      kExprLoop, kWasmVoid,
+        kExprLocalGet, 1,
+        kExprI32Const, 2,
+        kExprI32Shl,
+        kExprLocalGet, 1,
+        kExprI32StoreMem, 0, 0,
+        kExprLocalGet, 1,
+        kExprI32Const, 1,
+        kExprI32Add,
+        kExprLocalTee, 1,
+        kExprLocalGet, 0,
+        kExprI32LtS,
+        kExprBrIf, 0,
+      kExprEnd,
+      kExprLocalGet, 1,
+      kExprI32Const, 1,
+      kExprI32Sub,
+      kExprI32Const, 2,
+      kExprI32Shl,
+      kExprI32LoadMem, 0, 0])
+    .exportFunc();
+  let instance = builder.instantiate();
+  for (let n of [1, 2, 3, 8, 9, 1000]) {
+    assertEquals(n - 1, instance.exports.fill(n));
+  }
+  // Out-of-bounds accesses in the middle of the loop.
+  assertTraps(kTrapMemOutOfBounds, () => instance.exports.fill(20000));
+})();
@@ -0,0 +1,108 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler/turboshaft/load-elimination-reducer.h"
+
+#include "src/compiler/turboshaft/assembler.h"
+#include "src/compiler/turboshaft/graph.h"
+#include "src/compiler/turboshaft/optimization-phase.h"
+#include "test/common/flag-utils.h"
+#include "test/unittests/test-utils.h"
+
+namespace v8::internal::compiler::turboshaft {
+
+class LoadEliminationReducerTest : public TestWithZone {
+ public:
+  LoadEliminationReducerTest()
+      : input_graph_(zone()),
+        graph_(zone()),
+        assembler_(input_graph_, graph_, zone(), nullptr, std::tuple<>{}) {}
+
+ protected:
+  static constexpr int32_t kFieldOffset = 8;
+  static constexpr int32_t kElementsOffset = 16;
+
+  Graph& graph() { return graph_; }
+  Assembler<>& assembler() { return assembler_; }
+
+  OpIndex LoadField(OpIndex object) {
+    return assembler().Load(object, LoadOp::Kind::TaggedBase(),
+                            MemoryRepresentation::Int32(), kFieldOffset);
+  }
+  void StoreField(OpIndex object, OpIndex value) {
+    assembler().Store(object, value, StoreOp::Kind::TaggedBase(),
+                      MemoryRepresentation::Int32(),
+                      WriteBarrierKind::kNoWriteBarrier, kFieldOffset);
+  }
+  void StoreElement(OpIndex object, OpIndex index, OpIndex value) {
+    assembler().Store(object, index, value, StoreOp::Kind::TaggedBase(),
+                      MemoryRepresentation::Int32(),
+                      WriteBarrierKind::kNoWriteBarrier, kElementsOffset, 2);
+  }
+
+  // Runs the reducer on the graph built with {assembler()} and returns the
+  // number of loads left in its output.
+  size_t RunAndCountLoads() {
+    OptimizationPhase<LoadEliminationReducer>::Run(&graph(), zone(), nullptr);
+    size_t count = 0;
+    for (const Operation& op : graph().AllOperations()) {
+      if (op.Is<LoadOp>()) count++;
+    }
+    return count;
+  }
+
+ private:
+  Graph input_graph_;
+  Graph graph_;
+  Assembler<> assembler_;
+};
+
+// return o.a + o.a;
+TEST_F(LoadEliminationReducerTest, RedundantLoad) {
+  assembler().BindReachable(assembler().NewBlock());
+  OpIndex o = assembler().Parameter(0, RegisterRepresentation::Tagged());
+  OpIndex a = LoadField(o);
+  OpIndex b = LoadField(o);
+  assembler().Return(assembler().Word32Add(a, b));
+
+  EXPECT_EQ(1u, RunAndCountLoads());
+}
+
+TEST_F(LoadEliminationReducerTest, RedundantLoadWhenDisabled) {
+  FLAG_VALUE_SCOPE(turboshaft_load_elimination, false);
+  assembler().BindReachable(assembler().NewBlock());
+  OpIndex o = assembler().Parameter(0, RegisterRepresentation::Tagged());
+  OpIndex a = LoadField(o);
+  OpIndex b = LoadField(o);
+  assembler().Return(assembler().Word32Add(a, b));
+
+  EXPECT_EQ(2u, RunAndCountLoads());
+}
+
+// o.a = v; return o.a;
+TEST_F(LoadEliminationReducerTest, StoreToLoadForwarding) {
+  assembler().BindReachable(assembler().NewBlock());
+  OpIndex o = assembler().Parameter(0, RegisterRepresentation::Tagged());
+  OpIndex v = assembler().Parameter(1, RegisterRepresentation::Word32());
+  StoreField(o, v);
+  assembler().Return(LoadField(o));
+
+  EXPECT_EQ(0u, RunAndCountLoads());
+}
+
+// const x = o.a; o[i] = v; return x + o.a;
+TEST_F(LoadEliminationReducerTest, ElementStoreClobbersFields) {
+  assembler().BindReachable(assembler().NewBlock());
+  OpIndex o = assembler().Parameter(0, RegisterRepresentation::Tagged());
+  OpIndex i = assembler().Parameter(1, RegisterRepresentation::PointerSized());
+  OpIndex v = assembler().Parameter(2, RegisterRepresentation::Word32());
+  OpIndex a = LoadField(o);
+  StoreElement(o, i, v);
+  OpIndex b = LoadField(o);
+  assembler().Return(assembler().Word32Add(a, b));
+
+  EXPECT_EQ(2u, RunAndCountLoads());
+}
+
+}  // namespace v8::internal::compiler::turboshaft
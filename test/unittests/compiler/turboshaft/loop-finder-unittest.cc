@@ -0,0 +1,69 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler/turboshaft/loop-finder.h"
+
+#include "src/compiler/turboshaft/assembler.h"
+#include "src/compiler/turboshaft/graph.h"
+#include "test/unittests/test-utils.h"
+
+namespace v8::internal::compiler::turboshaft {
+
+class LoopFinderTest : public TestWithZone {};
+
+// Builds the graph of:
+//
+//   while (p) {
+//     if (p) { ... } else { ... }
+//   }
+//   return p;
+TEST_F(LoopFinderTest, LoopWithSeveralBlocks) {
+  Graph input_graph(zone());
+  Graph graph(zone());
+  Assembler<> assembler(input_graph, graph, zone(), nullptr, std::tuple<>{});
+
+  Block* start = assembler.NewBlock();
+  Block* header = assembler.NewLoopHeader();
+  Block* body = assembler.NewBlock();
+  Block* if_true = assembler.NewBlock();
+  Block* if_false = assembler.NewBlock();
+  Block* latch = assembler.NewBlock();
+  Block* exit = assembler.NewBlock();
+
+  assembler.BindReachable(start);
+  OpIndex p = assembler.Parameter(0, RegisterRepresentation::Word32());
+  assembler.Goto(header);
+  assembler.BindReachable(header);
+  assembler.Branch(p, body, exit);
+  assembler.BindReachable(body);
+  assembler.Branch(p, if_true, if_false);
+  assembler.BindReachable(if_true);
+  assembler.Goto(latch);
+  assembler.BindReachable(if_false);
+  assembler.Goto(latch);
+  assembler.BindReachable(latch);
+  assembler.Goto(header);
+  assembler.BindReachable(exit);
+  assembler.Return(p);
+
+  LoopFinder loop_finder(zone(), &graph);
+  EXPECT_EQ(1u, loop_finder.LoopHeaders().size());
+  const LoopFinder::LoopInfo& info = loop_finder.GetLoopInfo(header);
+  EXPECT_EQ(5u, info.block_count);
+  EXPECT_FALSE(info.has_inner_loops);
+  EXPECT_TRUE(info.is_well_ordered);
+
+  // The body doesn't depend on the walks that have been done before.
+  for (int i = 0; i < 2; i++) {
+    ZoneVector<const Block*> loop_body = loop_finder.GetLoopBody(header);
+    ASSERT_EQ(5u, loop_body.size());
+    EXPECT_EQ(header, loop_body[0]);
+    EXPECT_EQ(body, loop_body[1]);
+    EXPECT_EQ(if_true, loop_body[2]);
+    EXPECT_EQ(if_false, loop_body[3]);
+    EXPECT_EQ(latch, loop_body[4]);
+  }
+}
+
+}  // namespace v8::internal::compiler::turboshaft
@@ -0,0 +1,67 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler/turboshaft/loop-peeling-reducer.h"
+
+#include "src/compiler/turboshaft/assembler.h"
+#include "src/compiler/turboshaft/graph.h"
+#include "src/compiler/turboshaft/optimization-phase.h"
+#include "src/compiler/turboshaft/variable-reducer.h"
+#include "test/unittests/test-utils.h"
+
+namespace v8::internal::compiler::turboshaft {
+
+class LoopPeelingReducerTest : public TestWithZone {};
+
+// Builds the graph of:
+//
+//   while (c) {
+//     o.b = o.a;
+//   }
+//   return c;
+//
+// and checks that the loop body is emitted twice: once for the peeled
+// iteration and once in the loop.
+TEST_F(LoopPeelingReducerTest, PeelsInnermostLoop) {
+  Graph input_graph(zone());
+  Graph graph(zone());
+  Assembler<> assembler(input_graph, graph, zone(), nullptr, std::tuple<>{});
+
+  Block* start = assembler.NewBlock();
+  Block* header = assembler.NewLoopHeader();
+  Block* body = assembler.NewBlock();
+  Block* exit = assembler.NewBlock();
+
+  assembler.BindReachable(start);
+  OpIndex o = assembler.Parameter(0, RegisterRepresentation::Tagged());
+  OpIndex c = assembler.Parameter(1, RegisterRepresentation::Word32());
+  assembler.Goto(header);
+  assembler.BindReachable(header);
+  assembler.Branch(c, body, exit);
+  assembler.BindReachable(body);
+  OpIndex a = assembler.Load(o, LoadOp::Kind::TaggedBase(),
+                             MemoryRepresentation::Int32(), 8);
+  assembler.Store(o, a, StoreOp::Kind::TaggedBase(),
+                  MemoryRepresentation::Int32(),
+                  WriteBarrierKind::kNoWriteBarrier, 12);
+  assembler.Goto(header);
+  assembler.BindReachable(exit);
+  assembler.Return(c);
+
+  OptimizationPhase<LoopPeelingReducer, VariableReducer>::Run(&graph, zone(),
+                                                              nullptr);
+
+  size_t load_count = 0;
+  for (const Operation& op : graph.AllOperations()) {
+    if (op.Is<LoadOp>()) load_count++;
+  }
+  size_t loop_count = 0;
+  for (const Block& block : graph.blocks()) {
+    if (block.IsLoop()) loop_count++;
+  }
+  EXPECT_EQ(2u, load_count);
+  EXPECT_EQ(1u, loop_count);
+}
+
+}  // namespace v8::internal::compiler::turboshaft
@@ -65,6 +65,32 @@ TEST(ActiveSystemPagesTest, ReduceFullBitset) {
   EXPECT_EQ(original.Reduce(updated), size_t{63});
 }
 
+TEST(ActiveSystemPagesTest, Remove) {
+  ActiveSystemPages pages;
+  const size_t kPageSizeBits = 12;
+  const size_t kPageSize = size_t{1} << kPageSizeBits;
+  const size_t kWordSize = 8;
+  EXPECT_EQ(pages.Add(0, 4 * kPageSize, kPageSizeBits), size_t{4});
+
+  // Only pages fully contained in the range are removed.
+  EXPECT_EQ(pages.Remove(kWordSize, 3 * kPageSize - kWordSize, kPageSizeBits),
+            size_t{1});
+  EXPECT_EQ(pages.Size(kPageSizeBits), size_t{3} * kPageSize);
+
+  // Try to remove a page a second time.
+  EXPECT_EQ(pages.Remove(kPageSize, 3 * kPageSize, kPageSizeBits), size_t{1});
+  EXPECT_EQ(pages.Remove(kPageSize, 3 * kPageSize, kPageSizeBits), size_t{0});
+  EXPECT_EQ(pages.Size(kPageSizeBits), size_t{2} * kPageSize);
+}
+
+TEST(ActiveSystemPagesTest, RemoveFullBitset) {
+  ActiveSystemPages pages;
+  const size_t kPageSizeBits = 0;
+  EXPECT_EQ(pages.Add(0, 64, kPageSizeBits), size_t{64});
+  EXPECT_EQ(pages.Remove(0, 64, kPageSizeBits), size_t{64});
+  EXPECT_EQ(pages.Size(kPageSizeBits), size_t{0});
+}
+
 TEST(ActiveSystemPagesTest, Clear) {
   ActiveSystemPages pages;
   const size_t kPageSizeBits = 0;
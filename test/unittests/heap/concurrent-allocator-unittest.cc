@@ -0,0 +1,195 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/heap/concurrent-allocator.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "src/base/platform/time.h"
+#include "src/heap/concurrent-allocator-inl.h"
+#include "src/heap/heap.h"
+#include "src/heap/local-heap-inl.h"
+#include "src/heap/parked-scope.h"
+#include "test/unittests/test-utils.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace v8 {
+namespace internal {
+
+namespace {
+
+constexpr int kObjectSize = 8 * kTaggedSize;
+constexpr int kBytesPerThread = 2 * MB;
+
+class AllocatingThread final : public ParkingThread {
+ public:
+  explicit AllocatingThread(Heap* heap)
+      : ParkingThread(base::Thread::Options("AllocatingThread")),
+        heap_(heap) {}
+
+  void Run() override {
+    LocalHeap local_heap(heap_, ThreadKind::kBackground);
+    UnparkedScope unparked_scope(&local_heap);
+    for (int allocated = 0; allocated < kBytesPerThread;
+         allocated += kObjectSize) {
+      AllocationResult result = local_heap.AllocateRaw(
+          kObjectSize, AllocationType::kOld, AllocationOrigin::kRuntime,
+          AllocationAlignment::kTaggedAligned);
+      // Bail out instead of triggering a GC so that the measurement only
+      // covers the allocation paths.
+      if (result.IsFailure()) break;
+      heap_->CreateFillerObjectAtBackground(result.ToAddress(), kObjectSize);
+      allocated_bytes_ += kObjectSize;
+      if ((allocated / kObjectSize) % 1024 == 0) local_heap.Safepoint();
+    }
+  }
+
+  int allocated_bytes() const { return allocated_bytes_; }
+
+ private:
+  Heap* const heap_;
+  int allocated_bytes_ = 0;
+};
+
+// Allocates small old space objects through its own ConcurrentAllocator and
+// records the size of every LAB it hands out.
+class LabRecordingThread final : public ParkingThread {
+ public:
+  explicit LabRecordingThread(Heap* heap)
+      : ParkingThread(base::Thread::Options("LabRecordingThread")),
+        heap_(heap) {}
+
+  void Run() override;
+
+  const std::vector<size_t>& lab_sizes() const { return lab_sizes_; }
+  int max_lab_size_after_free() const { return max_lab_size_after_free_; }
+
+ private:
+  Heap* const heap_;
+  std::vector<size_t> lab_sizes_;
+  int max_lab_size_after_free_ = 0;
+};
+
+}  // namespace
+
+class ConcurrentAllocatorTest : public TestWithIsolate {
+ public:
+  // Lets |num_threads| background threads allocate small old space objects
+  // and returns the total number of allocated bytes per millisecond.
+  double MeasureThroughput(int num_threads) {
+    Heap* heap = i_isolate()->heap();
+    std::vector<std::unique_ptr<AllocatingThread>> threads;
+    ParkedScope parked(i_isolate()->main_thread_local_isolate());
+    base::TimeTicks start = base::TimeTicks::Now();
+    for (int i = 0; i < num_threads; i++) {
+      auto thread = std::make_unique<AllocatingThread>(heap);
+      CHECK(thread->Start());
+      threads.push_back(std::move(thread));
+    }
+    int64_t allocated_bytes = 0;
+    for (auto& thread : threads) {
+      thread->ParkedJoin(parked);
+      allocated_bytes += thread->allocated_bytes();
+    }
+    double duration_ms =
+        std::max((base::TimeTicks::Now() - start).InMillisecondsF(), 1.0);
+    return static_cast<double>(allocated_bytes) / duration_ms;
+  }
+
+  std::unique_ptr<LabRecordingThread> RecordLabs() {
+    auto thread = std::make_unique<LabRecordingThread>(i_isolate()->heap());
+    ParkedScope parked(i_isolate()->main_thread_local_isolate());
+    CHECK(thread->Start());
+    thread->ParkedJoin(parked);
+    return thread;
+  }
+
+  static Address lab_start(const ConcurrentAllocator& allocator) {
+    return allocator.lab_.start();
+  }
+  static size_t lab_size(const ConcurrentAllocator& allocator) {
+    return allocator.lab_.limit() - allocator.lab_.start();
+  }
+  static int max_lab_size(const ConcurrentAllocator& allocator) {
+    return allocator.max_lab_size_;
+  }
+};
+
+void LabRecordingThread::Run() {
+  LocalHeap local_heap(heap_, ThreadKind::kBackground);
+  UnparkedScope unparked_scope(&local_heap);
+  ConcurrentAllocator allocator(&local_heap, heap_->old_space(),
+                                ConcurrentAllocator::Context::kNotGC);
+  Address current_lab_start = kNullAddress;
+  for (int allocated = 0; allocated < kBytesPerThread;
+       allocated += kObjectSize) {
+    AllocationResult result =
+        allocator.AllocateRaw(kObjectSize, AllocationAlignment::kTaggedAligned,
+                              AllocationOrigin::kRuntime);
+    if (result.IsFailure()) break;
+    heap_->CreateFillerObjectAtBackground(result.ToAddress(), kObjectSize);
+    if (ConcurrentAllocatorTest::lab_start(allocator) != current_lab_start) {
+      current_lab_start = ConcurrentAllocatorTest::lab_start(allocator);
+      lab_sizes_.push_back(ConcurrentAllocatorTest::lab_size(allocator));
+    }
+    if ((allocated / kObjectSize) % 1024 == 0) local_heap.Safepoint();
+  }
+  allocator.FreeLinearAllocationArea();
+  max_lab_size_after_free_ = ConcurrentAllocatorTest::max_lab_size(allocator);
+}
+
+TEST_F(ConcurrentAllocatorTest, RefillThroughput) {
+  for (int num_threads : {1, 2, 4, 8}) {
+    double throughput = MeasureThroughput(num_threads);
+    RecordProperty("bytes_per_ms_" + std::to_string(num_threads) + "_threads",
+                   std::to_string(static_cast<int64_t>(throughput)));
+    CHECK_LT(0, throughput);
+  }
+}
+
+TEST_F(ConcurrentAllocatorTest, LabSizeGrowsOnRefill) {
+  const bool adaptive_lab_size =
+      v8_flags.concurrent_allocator_adaptive_lab_size;
+
+  // Without adaptation every refill hands out at most kMaxLabSize.
+  v8_flags.concurrent_allocator_adaptive_lab_size = false;
+  std::unique_ptr<LabRecordingThread> fixed = RecordLabs();
+  ASSERT_FALSE(fixed->lab_sizes().empty());
+  for (size_t size : fixed->lab_sizes()) {
+    EXPECT_LE(static_cast<size_t>(ConcurrentAllocator::kMinLabSize), size);
+    EXPECT_GE(static_cast<size_t>(ConcurrentAllocator::kMaxLabSize), size);
+  }
+
+  // With adaptation the maximum doubles on every refill up to
+  // kMaxAdaptiveLabSize.
+  v8_flags.concurrent_allocator_adaptive_lab_size = true;
+  std::unique_ptr<LabRecordingThread> adaptive = RecordLabs();
+  ASSERT_FALSE(adaptive->lab_sizes().empty());
+  size_t max_size = ConcurrentAllocator::kMaxLabSize;
+  bool grew = false;
+  for (size_t size : adaptive->lab_sizes()) {
+    EXPECT_LE(static_cast<size_t>(ConcurrentAllocator::kMinLabSize), size);
+    EXPECT_GE(max_size, size);
+    if (size > static_cast<size_t>(ConcurrentAllocator::kMaxLabSize)) {
+      grew = true;
+    }
+    max_size = std::min(
+        2 * max_size,
+        static_cast<size_t>(ConcurrentAllocator::kMaxAdaptiveLabSize));
+  }
+  EXPECT_TRUE(grew);
+  // Larger LABs mean fewer refills, i.e., fewer trips to the space mutex.
+  EXPECT_LT(adaptive->lab_sizes().size(), fixed->lab_sizes().size());
+  // Giving back the LAB resets the adaptive size.
+  EXPECT_EQ(ConcurrentAllocator::kMaxLabSize,
+            adaptive->max_lab_size_after_free());
+
+  v8_flags.concurrent_allocator_adaptive_lab_size = adaptive_lab_size;
+}
+
+}  // namespace internal
+}  // namespace v8
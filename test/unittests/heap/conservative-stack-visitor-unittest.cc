@@ -88,6 +88,7 @@ TEST_F(ConservativeStackVisitorTest, DirectBasePointer) {
     ConservativeStackVisitor stack_visitor(isolate(), recorder.get());
     SaveStackContextScope stack_context_scope(&heap()->stack());
     isolate()->heap()->stack().IteratePointers(&stack_visitor);
+    stack_visitor.VisitCollectedPointers();
 
     // Make sure to keep the pointer alive.
     EXPECT_NE(kNullAddress, ptr);
@@ -110,6 +111,7 @@ TEST_F(ConservativeStackVisitorTest, TaggedBasePointer) {
     ConservativeStackVisitor stack_visitor(isolate(), recorder.get());
     SaveStackContextScope stack_context_scope(&heap()->stack());
     isolate()->heap()->stack().IteratePointers(&stack_visitor);
+    stack_visitor.VisitCollectedPointers();
 
     // Make sure to keep the pointer alive.
     EXPECT_NE(kNullAddress, ptr);
@@ -132,6 +134,7 @@ TEST_F(ConservativeStackVisitorTest, InnerPointer) {
     ConservativeStackVisitor stack_visitor(isolate(), recorder.get());
     SaveStackContextScope stack_context_scope(&heap()->stack());
     isolate()->heap()->stack().IteratePointers(&stack_visitor);
+    stack_visitor.VisitCollectedPointers();
 
     // Make sure to keep the pointer alive.
     EXPECT_NE(kNullAddress, ptr);
@@ -156,6 +159,7 @@ TEST_F(ConservativeStackVisitorTest, HalfWord1) {
     ConservativeStackVisitor stack_visitor(isolate(), recorder.get());
     SaveStackContextScope stack_context_scope(&heap()->stack());
     isolate()->heap()->stack().IteratePointers(&stack_visitor);
+    stack_visitor.VisitCollectedPointers();
 
     // Make sure to keep the pointer alive.
     EXPECT_NE(static_cast<uint32_t>(0), ptr[0]);
@@ -178,6 +182,7 @@ TEST_F(ConservativeStackVisitorTest, HalfWord2) {
     ConservativeStackVisitor stack_visitor(isolate(), recorder.get());
     SaveStackContextScope stack_context_scope(&heap()->stack());
     isolate()->heap()->stack().IteratePointers(&stack_visitor);
+    stack_visitor.VisitCollectedPointers();
 
     // Make sure to keep the pointer alive.
     EXPECT_NE(static_cast<uint32_t>(0), ptr[1]);
@@ -200,6 +205,7 @@ TEST_F(ConservativeStackVisitorTest, InnerHalfWord1) {
     ConservativeStackVisitor stack_visitor(isolate(), recorder.get());
     SaveStackContextScope stack_context_scope(&heap()->stack());
     isolate()->heap()->stack().IteratePointers(&stack_visitor);
+    stack_visitor.VisitCollectedPointers();
 
     // Make sure to keep the pointer alive.
     EXPECT_NE(static_cast<uint32_t>(0), ptr[0]);
@@ -222,6 +228,7 @@ TEST_F(ConservativeStackVisitorTest, InnerHalfWord2) {
     ConservativeStackVisitor stack_visitor(isolate(), recorder.get());
     SaveStackContextScope stack_context_scope(&heap()->stack());
     isolate()->heap()->stack().IteratePointers(&stack_visitor);
+    stack_visitor.VisitCollectedPointers();
 
     // Make sure to keep the pointer alive.
     EXPECT_NE(static_cast<uint32_t>(0), ptr[1]);
@@ -23,6 +23,13 @@ class CompactableCustomSpace : public CustomSpace<CompactableCustomSpace> {
   static constexpr bool kSupportsCompaction = true;
 };
 
+class OtherCompactableCustomSpace
+    : public CustomSpace<OtherCompactableCustomSpace> {
+ public:
+  static constexpr size_t kSpaceIndex = 1;
+  static constexpr bool kSupportsCompaction = true;
+};
+
 namespace internal {
 
 namespace {
@@ -63,12 +70,40 @@ struct CompactableHolder
   CompactableGCed* objects[kNumObjects]{};
 };
 
+// Lives in OtherCompactableCustomSpace and refers to an object in
+// CompactableCustomSpace.
+struct OtherSpaceCompactableGCed
+    : public GarbageCollected<OtherSpaceCompactableGCed> {
+ public:
+  void Trace(Visitor* visitor) const {
+    VisitorBase::TraceRawForTesting(visitor,
+                                    const_cast<const CompactableGCed*>(other));
+    visitor->RegisterMovableReference(
+        const_cast<const CompactableGCed**>(&other));
+  }
+  CompactableGCed* other = nullptr;
+};
+
+struct OtherSpaceCompactableHolder
+    : public GarbageCollected<OtherSpaceCompactableHolder> {
+ public:
+  void Trace(Visitor* visitor) const {
+    VisitorBase::TraceRawForTesting(
+        visitor, const_cast<const OtherSpaceCompactableGCed*>(object));
+    visitor->RegisterMovableReference(
+        const_cast<const OtherSpaceCompactableGCed**>(&object));
+  }
+  OtherSpaceCompactableGCed* object = nullptr;
+};
+
 class CompactorTest : public testing::TestWithPlatform {
  public:
   CompactorTest() {
     Heap::HeapOptions options;
     options.custom_spaces.emplace_back(
         std::make_unique<CompactableCustomSpace>());
+    options.custom_spaces.emplace_back(
+        std::make_unique<OtherCompactableCustomSpace>());
     heap_ = Heap::Create(platform_, std::move(options));
   }
 
@@ -118,6 +153,11 @@ struct SpaceTrait<internal::CompactableGCed> {
   using Space = CompactableCustomSpace;
 };
 
+template <>
+struct SpaceTrait<internal::OtherSpaceCompactableGCed> {
+  using Space = OtherCompactableCustomSpace;
+};
+
 namespace internal {
 
 TEST_F(CompactorTest, NothingToCompact) {
@@ -244,5 +284,25 @@ TEST_F(CompactorTest, InteriorSlotToNextObject) {
   EXPECT_EQ(references[1], holder->objects[1]->other);
 }
 
+TEST_F(CompactorTest, InteriorSlotToOtherSpace) {
+  Persistent<OtherSpaceCompactableHolder> holder =
+      MakeGarbageCollected<OtherSpaceCompactableHolder>(GetAllocationHandle());
+  // Both spaces start with a dead object so that the live objects of both
+  // spaces are moved.
+  OtherSpaceCompactableGCed* dead_in_other_space =
+      MakeGarbageCollected<OtherSpaceCompactableGCed>(GetAllocationHandle());
+  CompactableGCed* dead =
+      MakeGarbageCollected<CompactableGCed>(GetAllocationHandle());
+  holder->object =
+      MakeGarbageCollected<OtherSpaceCompactableGCed>(GetAllocationHandle());
+  holder->object->other =
+      MakeGarbageCollected<CompactableGCed>(GetAllocationHandle());
+  StartGC();
+  EndGC();
+  EXPECT_EQ(1u, CompactableGCed::g_destructor_callcount);
+  EXPECT_EQ(dead_in_other_space, holder->object);
+  EXPECT_EQ(dead, holder->object->other);
+}
+
 }  // namespace internal
 }  // namespace cppgc
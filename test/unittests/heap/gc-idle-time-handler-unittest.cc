@@ -70,6 +70,20 @@ TEST(GCIdleTimeHandler, EstimateMarkingStepSizeOverflow2) {
             step_size);
 }
 
+TEST(GCIdleTimeHandler, EstimateFinalIncrementalMarkCompactTimeInitial) {
+  size_t speed =
+      GCIdleTimeHandler::kInitialConservativeFinalIncrementalMarkCompactSpeed;
+  EXPECT_EQ(100, GCIdleTimeHandler::EstimateFinalIncrementalMarkCompactTime(
+                     100 * speed, 0));
+}
+
+
+TEST(GCIdleTimeHandler, EstimateFinalIncrementalMarkCompactTimeOverflow) {
+  EXPECT_EQ(GCIdleTimeHandler::kMaxFinalIncrementalMarkCompactTimeInMs,
+            GCIdleTimeHandler::EstimateFinalIncrementalMarkCompactTime(
+                std::numeric_limits<size_t>::max(), 1));
+}
+
 TEST_F(GCIdleTimeHandlerTest, IncrementalMarking1) {
   if (!handler()->Enabled()) return;
   GCIdleTimeHeapState heap_state = DefaultHeapState();
@@ -127,5 +141,65 @@ TEST_F(GCIdleTimeHandlerTest, DoneIfNotMakingProgressOnIncrementalMarking) {
             handler()->Compute(idle_time_ms, heap_state));
 }
 
+
+TEST_F(GCIdleTimeHandlerTest, IncrementalStepInShortIdleTime) {
+  if (!handler()->Enabled()) return;
+  GCIdleTimeHeapState heap_state = DefaultHeapState();
+  double idle_time_ms = 0.5;
+  EXPECT_EQ(GCIdleTimeAction::kIncrementalStep,
+            handler()->Compute(idle_time_ms, heap_state));
+}
+
+
+TEST_F(GCIdleTimeHandlerTest, FinalizeIncrementalMarking) {
+  if (!handler()->Enabled()) return;
+  GCIdleTimeHeapState heap_state = DefaultHeapState();
+  heap_state.incremental_marking_complete = true;
+  heap_state.final_incremental_mark_compact_speed_in_bytes_per_ms =
+      kMarkCompactSpeed;
+  double idle_time_ms = static_cast<double>(kSizeOfObjects / kMarkCompactSpeed);
+  EXPECT_EQ(GCIdleTimeAction::kFinalizeIncrementalMarking,
+            handler()->Compute(2 * idle_time_ms, heap_state));
+  // The final pause would not fit into the idle time.
+  EXPECT_EQ(GCIdleTimeAction::kDone,
+            handler()->Compute(idle_time_ms / 2, heap_state));
+  heap_state.sweeping_in_progress = true;
+  EXPECT_EQ(GCIdleTimeAction::kSweep,
+            handler()->Compute(idle_time_ms / 2, heap_state));
+}
+
+
+TEST_F(GCIdleTimeHandlerTest, SweepWhileSweepingInProgress) {
+  if (!handler()->Enabled()) return;
+  GCIdleTimeHeapState heap_state = DefaultHeapState();
+  heap_state.incremental_marking_stopped = true;
+  heap_state.sweeping_in_progress = true;
+  heap_state.pooled_chunks = 1;
+  double idle_time_ms = 1.0;
+  EXPECT_EQ(GCIdleTimeAction::kSweep,
+            handler()->Compute(idle_time_ms, heap_state));
+}
+
+
+TEST_F(GCIdleTimeHandlerTest, ReleasePooledMemoryOnlyInLongIdleTime) {
+  if (!handler()->Enabled()) return;
+  GCIdleTimeHeapState heap_state = DefaultHeapState();
+  heap_state.incremental_marking_stopped = true;
+  heap_state.pooled_chunks = 1;
+  EXPECT_EQ(GCIdleTimeAction::kDone,
+            handler()->Compute(
+                GCIdleTimeHandler::kMinIdleTimeToReleasePooledMemoryInMs - 1,
+                heap_state));
+  EXPECT_EQ(GCIdleTimeAction::kReleasePooledMemory,
+            handler()->Compute(
+                GCIdleTimeHandler::kMinIdleTimeToReleasePooledMemoryInMs,
+                heap_state));
+  heap_state.pooled_chunks = 0;
+  EXPECT_EQ(GCIdleTimeAction::kDone,
+            handler()->Compute(
+                GCIdleTimeHandler::kMinIdleTimeToReleasePooledMemoryInMs,
+                heap_state));
+}
+
 }  // namespace internal
 }  // namespace v8
@@ -0,0 +1,62 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/heap/gc-pause-controller.h"
+
+#include "src/heap/heap.h"
+#include "test/unittests/test-utils.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace v8 {
+namespace internal {
+
+using GCPauseControllerTest = TestWithIsolate;
+
+TEST_F(GCPauseControllerTest, DisabledByDefault) {
+  if (v8_flags.gc_pause_target_ms > 0) return;
+  GCPauseController controller(i_isolate()->heap());
+  EXPECT_FALSE(controller.IsEnabled());
+  EXPECT_EQ(5.0, controller.IncrementalMarkingStepInMs(5.0));
+  EXPECT_TRUE(controller.AllowsNewSpaceCapacity(64 * MB));
+  if (v8_flags.compaction_pause_budget_ms == 0) {
+    EXPECT_EQ(0.0, controller.CompactionBudgetInMs());
+  }
+}
+
+TEST_F(GCPauseControllerTest, TargetBoundsSteps) {
+  GCPauseController controller(i_isolate()->heap());
+  controller.SetMaxPause(2.0);
+  EXPECT_TRUE(controller.IsEnabled());
+  EXPECT_EQ(2.0, controller.IncrementalMarkingStepInMs(5.0));
+  EXPECT_EQ(1.0, controller.IncrementalMarkingStepInMs(1.0));
+  controller.SetMaxPause(-1.0);
+  EXPECT_FALSE(controller.IsEnabled());
+}
+
+TEST_F(GCPauseControllerTest, CorrectionFollowsObservedPauses) {
+  if (v8_flags.compaction_pause_budget_ms > 0) return;
+  GCPauseController controller(i_isolate()->heap());
+  controller.SetMaxPause(10.0);
+  const double initial_budget = controller.CompactionBudgetInMs();
+  EXPECT_EQ(10.0 * GCPauseController::kCompactionShare, initial_budget);
+
+  // Full GC pauses that take twice as long as predicted move the correction
+  // towards 2 and shrink the evacuation budget.
+  for (int i = 0; i < 20; i++) {
+    double predicted = 5.0 * controller.full_correction_;
+    controller.NotifyPause(false, predicted, 10.0);
+  }
+  EXPECT_NEAR(2.0, controller.full_correction_, 0.01);
+  EXPECT_EQ(1.0, controller.young_correction_);
+  EXPECT_LT(controller.CompactionBudgetInMs(), initial_budget);
+
+  // The correction is bounded.
+  for (int i = 0; i < 50; i++) {
+    controller.NotifyPause(true, 1.0, 100.0);
+  }
+  EXPECT_EQ(GCPauseController::kMaxCorrection, controller.young_correction_);
+}
+
+}  // namespace internal
+}  // namespace v8
@@ -415,6 +415,33 @@ TEST_F(GCTracerTest, BackgroundScavengerScope) {
               .scopes[GCTracer::Scope::SCAVENGER_BACKGROUND_SCAVENGE_PARALLEL]);
 }
 
+TEST_F(GCTracerTest, ScavengerParallelWork) {
+  if (v8_flags.stress_incremental_marking) return;
+  GCTracer* tracer = i_isolate()->heap()->tracer();
+  tracer->ResetForTesting();
+  StartTracing(tracer, GarbageCollector::SCAVENGER, StartTracingMode::kAtomic);
+  tracer->AddScavengerParallelWork(10, 2, 3);
+  tracer->AddScavengerParallelWork(5, 1, 2);
+  StopTracing(tracer, GarbageCollector::SCAVENGER);
+  EXPECT_DOUBLE_EQ(15, tracer->current_.scavenger_parallel_busy_time);
+  EXPECT_DOUBLE_EQ(3, tracer->current_.scavenger_parallel_idle_time);
+  EXPECT_EQ(3, tracer->current_.scavenger_parallel_tasks);
+}
+
+TEST_F(GCTracerTest, CompactionCandidates) {
+  if (v8_flags.stress_incremental_marking) return;
+  GCTracer* tracer = i_isolate()->heap()->tracer();
+  tracer->ResetForTesting();
+  StartTracing(tracer, GarbageCollector::MARK_COMPACTOR,
+               StartTracingMode::kAtomic);
+  tracer->AddCompactionCandidates(4, 2, 100);
+  tracer->AddCompactionCandidates(1, 3, 20);
+  StopTracing(tracer, GarbageCollector::MARK_COMPACTOR);
+  EXPECT_EQ(5, tracer->current_.compaction_candidate_pages);
+  EXPECT_EQ(5, tracer->current_.compaction_deferred_pages);
+  EXPECT_EQ(120u, tracer->current_.compaction_candidate_live_bytes);
+}
+
 TEST_F(GCTracerTest, BackgroundMinorMCScope) {
   if (v8_flags.stress_incremental_marking) return;
   GCTracer* tracer = i_isolate()->heap()->tracer();
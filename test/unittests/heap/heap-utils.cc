@@ -79,7 +79,7 @@ void FillPageInPagedSpace(Page* page,
   // Collect all free list block sizes
   page->ForAllFreeListCategories(
       [&available_sizes](FreeListCategory* category) {
-        category->IterateNodesForTesting([&available_sizes](FreeSpace node) {
+        category->IterateNodes([&available_sizes](FreeSpace node) {
           int node_size = node.Size();
           if (node_size >= kMaxRegularHeapObjectSize) {
             available_sizes.push_back(node_size);
@@ -112,7 +112,7 @@ void FillPageInPagedSpace(Page* page,
         remaining_sizes.push_back({});
         std::vector<int>& sizes_in_category =
             remaining_sizes[remaining_sizes.size() - 1];
-        category->IterateNodesForTesting([&sizes_in_category](FreeSpace node) {
+        category->IterateNodes([&sizes_in_category](FreeSpace node) {
           int node_size = node.Size();
           DCHECK_LT(0, FixedArrayLenFromSize(node_size));
           sizes_in_category.push_back(node_size);
@@ -0,0 +1,77 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/heap/mark-compact.h"
+
+#include <vector>
+
+#include "src/flags/flags.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace v8 {
+namespace internal {
+
+namespace {
+
+constexpr size_t kAreaSize = 256 * KB;
+
+// Pages that qualify for evacuation, sorted by live bytes. The pages
+// themselves are not needed for the selection.
+std::vector<MarkCompactCollector::LiveBytesPagePair> MakePages(
+    std::initializer_list<size_t> live_bytes) {
+  std::vector<MarkCompactCollector::LiveBytesPagePair> pages;
+  for (size_t bytes : live_bytes) {
+    pages.push_back(std::make_pair(bytes, nullptr));
+  }
+  return pages;
+}
+
+}  // namespace
+
+TEST(MarkCompactCollectorTest, RemainingEvacuationBudget) {
+  const double speed = 1.0 * MB;
+  EXPECT_EQ(size_t{2} * MB,
+            MarkCompactCollector::RemainingEvacuationBudget(speed, 2.0, 0));
+  // Candidates selected in other spaces use up the budget of this cycle.
+  EXPECT_EQ(size_t{MB} / 2, MarkCompactCollector::RemainingEvacuationBudget(
+                                speed, 2.0, size_t{3} * MB / 2));
+  EXPECT_EQ(0u, MarkCompactCollector::RemainingEvacuationBudget(
+                    speed, 2.0, size_t{3} * MB));
+}
+
+TEST(MarkCompactCollectorTest, CandidatesWithinBudget) {
+  if (v8_flags.compact_on_every_full_gc) return;
+  auto pages = MakePages({16 * KB, 32 * KB, 64 * KB, 128 * KB, 200 * KB});
+  size_t total_live_bytes = 0;
+
+  // Everything fits.
+  EXPECT_EQ(5, MarkCompactCollector::ComputeEvacuationCandidateCount(
+                   pages, kAreaSize, 4 * MB, &total_live_bytes));
+  EXPECT_EQ(size_t{440} * KB, total_live_bytes);
+
+  // Once the budget is used up, the remaining pages are left for a later
+  // cycle.
+  EXPECT_EQ(2, MarkCompactCollector::ComputeEvacuationCandidateCount(
+                   pages, kAreaSize, 100 * KB, &total_live_bytes));
+  EXPECT_EQ(size_t{48} * KB, total_live_bytes);
+
+  // No page fits into a budget that is already used up.
+  EXPECT_EQ(0, MarkCompactCollector::ComputeEvacuationCandidateCount(
+                   pages, kAreaSize, 8 * KB, &total_live_bytes));
+  EXPECT_EQ(0u, total_live_bytes);
+}
+
+TEST(MarkCompactCollectorTest, CandidatesMustReleasePages) {
+  if (v8_flags.compact_on_every_full_gc) return;
+  // Evacuating a single page would need a new page for its live objects, so
+  // nothing is selected.
+  auto pages = MakePages({200 * KB, 220 * KB});
+  size_t total_live_bytes = 0;
+  EXPECT_EQ(0, MarkCompactCollector::ComputeEvacuationCandidateCount(
+                   pages, kAreaSize, 300 * KB, &total_live_bytes));
+  EXPECT_EQ(0u, total_live_bytes);
+}
+
+}  // namespace internal
+}  // namespace v8
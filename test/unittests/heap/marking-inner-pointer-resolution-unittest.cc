@@ -2,6 +2,8 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
+
 #include "src/heap/gc-tracer.h"
 #include "src/heap/mark-compact.h"
 #include "test/unittests/heap/heap-utils.h"
@@ -247,21 +249,44 @@ class InnerPointerResolutionTest : public TestWithIsolate {
     EXPECT_EQ(kNullAddress, base_ptr);
   }
 
+  // Checks that resolving all `ptrs` in one batch finds the same objects as
+  // resolving them one by one.
+  void RunTestBatched(std::vector<Address> ptrs) {
+    std::sort(ptrs.begin(), ptrs.end());
+    ptrs.erase(std::unique(ptrs.begin(), ptrs.end()), ptrs.end());
+    std::vector<Address> expected;
+    for (Address ptr : ptrs) {
+      Address base_ptr = collector()->FindBasePtrForMarking(ptr);
+      if (base_ptr != kNullAddress) expected.push_back(base_ptr);
+    }
+    std::sort(expected.begin(), expected.end());
+    expected.erase(std::unique(expected.begin(), expected.end()),
+                   expected.end());
+    std::vector<Address> base_ptrs;
+    collector()->FindBasePtrsForMarking(ptrs, &base_ptrs);
+    EXPECT_EQ(expected, base_ptrs);
+  }
+
   void TestAll() {
+    std::vector<Address> ptrs;
     for (auto object : objects_) {
-      RunTestInside(object, 0);
-      RunTestInside(object, 1);
-      RunTestInside(object, object.size / 2);
-      RunTestInside(object, object.size - 1);
+      for (int offset : {0, 1, object.size / 2, object.size - 1}) {
+        RunTestInside(object, offset);
+        ptrs.push_back(object.address + offset);
+      }
     }
     for (auto [id, page] : pages_) {
       const Address outside_ptr = page->area_start() - 42;
       DCHECK_LE(page->address(), outside_ptr);
       RunTestOutside(outside_ptr);
+      ptrs.push_back(outside_ptr);
+    }
+    for (Address outside_ptr : {kNullAddress, static_cast<Address>(42),
+                                static_cast<Address>(kZapValue)}) {
+      RunTestOutside(outside_ptr);
+      ptrs.push_back(outside_ptr);
     }
-    RunTestOutside(kNullAddress);
-    RunTestOutside(static_cast<Address>(42));
-    RunTestOutside(static_cast<Address>(kZapValue));
+    RunTestBatched(std::move(ptrs));
   }
 
  private:
@@ -0,0 +1,72 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/heap/object-lifetime-tracker.h"
+
+#include <numeric>
+
+#include "src/heap/heap.h"
+#include "src/heap/new-spaces.h"
+#include "src/objects/fixed-array-inl.h"
+#include "src/objects/objects-inl.h"
+#include "test/unittests/heap/heap-utils.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace v8 {
+namespace internal {
+
+namespace {
+
+size_t Sum(const ObjectLifetimeTracker::AgeHistogram& histogram) {
+  return std::accumulate(histogram.begin(), histogram.end(), size_t{0});
+}
+
+}  // namespace
+
+class ObjectLifetimeTrackerTest : public TestWithHeapInternalsAndContext {
+ public:
+  void YoungGCWithTracker(ObjectLifetimeTracker& tracker) {
+    tracker.NotifyGCPrologue();
+    YoungGC();
+    tracker.NotifyGCEpilogue(v8_flags.minor_mc
+                                 ? GarbageCollector::MINOR_MARK_COMPACTOR
+                                 : GarbageCollector::SCAVENGER);
+  }
+};
+
+TEST_F(ObjectLifetimeTrackerTest, RecordsDeathsAndPromotions) {
+  if (v8_flags.single_generation) return;
+  ManualGCScope manual_gc_scope(i_isolate());
+  ObjectLifetimeTracker tracker(heap(), kTaggedSize);
+  Factory* factory = i_isolate()->factory();
+  HandleScope scope(i_isolate());
+
+  heap()->new_space()->AddAllocationObserver(&tracker);
+  Handle<FixedArray> survivor = factory->NewFixedArray(16);
+  {
+    HandleScope inner_scope(i_isolate());
+    for (int i = 0; i < 16; i++) factory->NewFixedArray(16);
+  }
+  heap()->new_space()->RemoveAllocationObserver(&tracker);
+  EXPECT_LT(0u, tracker.tracked_samples());
+
+  // Garbage dies in the first GC, the survivor is promoted at the latest in
+  // the second one.
+  YoungGCWithTracker(tracker);
+  YoungGCWithTracker(tracker);
+
+  const ObjectLifetimeTracker::AgeHistogram& deaths =
+      tracker.deaths(FIXED_ARRAY_TYPE);
+  EXPECT_LT(0u, deaths[0]);
+  EXPECT_EQ(deaths[0], Sum(deaths));
+  const ObjectLifetimeTracker::AgeHistogram& promotions =
+      tracker.promotions(FIXED_ARRAY_TYPE);
+  EXPECT_LT(0u, Sum(promotions));
+  EXPECT_EQ(0u, promotions[0]);
+  EXPECT_FALSE(Heap::InYoungGeneration(*survivor));
+  EXPECT_EQ(0u, tracker.tracked_samples());
+}
+
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,104 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/heap/pretenuring-handler.h"
+
+#include "src/heap/factory.h"
+#include "src/objects/allocation-site-inl.h"
+#include "test/unittests/heap/heap-utils.h"
+
+namespace v8 {
+namespace internal {
+namespace heap {
+
+namespace {
+
+class PretenuringHandlerTest : public TestWithHeapInternalsAndContext {
+ public:
+  Handle<AllocationSite> NewSite(AllocationSite::PretenureDecision decision) {
+    Handle<AllocationSite> site = factory()->NewAllocationSite(true);
+    site->set_pretenure_decision(decision);
+    return site;
+  }
+
+  // Simulates a GC cycle in which {created} mementos were created for {site}
+  // and {found} of them were found behind surviving objects.
+  void RunCycle(Handle<AllocationSite> site, int created, int found) {
+    site->set_memento_create_count(site->memento_create_count() + created);
+    if (found > 0) {
+      PretenuringHandler::PretenuringFeedbackMap feedback;
+      feedback.insert(std::make_pair(*site, found));
+      pretenuring_handler()->MergeAllocationSitePretenuringFeedback(feedback);
+    }
+    pretenuring_handler()->ProcessPretenuringFeedback();
+  }
+
+  PretenuringHandler* pretenuring_handler() {
+    return heap()->pretenuring_handler();
+  }
+};
+
+constexpr int kCreated = 4 * AllocationSite::kPretenureMinimumCreated;
+
+}  // namespace
+
+TEST_F(PretenuringHandlerTest, FeedbackIsResetWithoutDecay) {
+  if (!v8_flags.allocation_site_pretenuring) return;
+  v8_flags.allocation_site_pretenuring_decay = false;
+  HandleScope scope(isolate());
+  Handle<AllocationSite> site = NewSite(AllocationSite::kUndecided);
+  RunCycle(site, kCreated, kCreated / 4);
+  EXPECT_EQ(AllocationSite::kDontTenure, site->pretenure_decision());
+  EXPECT_EQ(0, site->memento_create_count());
+  EXPECT_EQ(0, site->memento_found_count());
+}
+
+TEST_F(PretenuringHandlerTest, DecayKeepsHalfOfTheFeedback) {
+  if (!v8_flags.allocation_site_pretenuring) return;
+  v8_flags.allocation_site_pretenuring_decay = true;
+  HandleScope scope(isolate());
+  Handle<AllocationSite> site = NewSite(AllocationSite::kUndecided);
+  RunCycle(site, kCreated, kCreated / 4);
+  EXPECT_EQ(AllocationSite::kDontTenure, site->pretenure_decision());
+  EXPECT_EQ(kCreated / 2, site->memento_create_count());
+  EXPECT_EQ(kCreated / 8, site->memento_found_count());
+
+  // All objects of the next cycle survive, but the history still keeps the
+  // ratio below the pretenuring threshold.
+  RunCycle(site, kCreated / 2, kCreated / 2);
+  EXPECT_EQ(AllocationSite::kDontTenure, site->pretenure_decision());
+
+  // As the history fades out, the don't tenure decision is reconsidered.
+  RunCycle(site, kCreated / 2, kCreated / 2);
+  RunCycle(site, kCreated / 2, kCreated / 2);
+  EXPECT_NE(AllocationSite::kDontTenure, site->pretenure_decision());
+  v8_flags.allocation_site_pretenuring_decay = false;
+}
+
+TEST_F(PretenuringHandlerTest, TenuredSiteWithoutSurvivorsIsUntenured) {
+  if (!v8_flags.allocation_site_pretenuring) return;
+  v8_flags.allocation_site_pretenuring_decay = true;
+  HandleScope scope(isolate());
+  Handle<AllocationSite> site = NewSite(AllocationSite::kTenure);
+  // None of the mementos survive, so the site has no entry in the feedback
+  // storage in this cycle.
+  RunCycle(site, kCreated, 0);
+  EXPECT_EQ(AllocationSite::kDontTenure, site->pretenure_decision());
+  EXPECT_EQ(AllocationType::kYoung, site->GetAllocationType());
+  EXPECT_TRUE(site->deopt_dependent_code());
+  v8_flags.allocation_site_pretenuring_decay = false;
+}
+
+TEST_F(PretenuringHandlerTest, TenuredSiteStaysTenuredWithoutDecay) {
+  if (!v8_flags.allocation_site_pretenuring) return;
+  v8_flags.allocation_site_pretenuring_decay = false;
+  HandleScope scope(isolate());
+  Handle<AllocationSite> site = NewSite(AllocationSite::kTenure);
+  RunCycle(site, kCreated, kCreated / 4);
+  EXPECT_EQ(AllocationSite::kTenure, site->pretenure_decision());
+}
+
+}  // namespace heap
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,104 @@
+// Copyright 2023 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/heap/scavenger.h"
+
+#include "src/flags/flags.h"
+#include "src/handles/handles-inl.h"
+#include "src/heap/heap.h"
+#include "src/objects/fixed-array-inl.h"
+#include "test/unittests/heap/heap-utils.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace v8 {
+namespace internal {
+
+namespace {
+
+constexpr int kRegularHolderLength = 1024;
+// Large enough to end up in large object space.
+constexpr int kLargeHolderLength = 64 * KB;
+constexpr int kChainLength = 8;
+
+class ScavengerTest : public TestWithHeapInternalsAndContext {
+ public:
+  // Fills |holder| with chains of young arrays. Each chain is only reachable
+  // through an old-to-new slot, so that scavenging it requires both remembered
+  // set and copied list processing.
+  void FillWithYoungChains(Handle<FixedArray> holder) {
+    Factory* factory = isolate()->factory();
+    for (int i = 0; i < holder->length(); ++i) {
+      HandleScope scope(isolate());
+      Handle<FixedArray> head = factory->NewFixedArray(2);
+      head->set(0, Smi::FromInt(i));
+      Handle<FixedArray> current = head;
+      for (int j = 1; j < kChainLength; ++j) {
+        Handle<FixedArray> next = factory->NewFixedArray(2);
+        next->set(0, Smi::FromInt(i));
+        current->set(1, *next);
+        current = next;
+      }
+      holder->set(i, *head);
+    }
+  }
+
+  void VerifyYoungChains(Handle<FixedArray> holder) {
+    for (int i = 0; i < holder->length(); ++i) {
+      FixedArray current = FixedArray::cast(holder->get(i));
+      for (int j = 0; j < kChainLength; ++j) {
+        CHECK_EQ(i, Smi::ToInt(current.get(0)));
+        if (j + 1 < kChainLength) current = FixedArray::cast(current.get(1));
+      }
+    }
+  }
+
+  void RunStress() {
+    if (v8_flags.single_generation || v8_flags.minor_mc) return;
+    ManualGCScope manual_gc_scope(isolate());
+    HandleScope scope(isolate());
+    Factory* factory = isolate()->factory();
+
+    std::vector<Handle<FixedArray>> holders;
+    for (int i = 0; i < 8; ++i) {
+      holders.push_back(
+          factory->NewFixedArray(kRegularHolderLength, AllocationType::kOld));
+    }
+    holders.push_back(
+        factory->NewFixedArray(kLargeHolderLength, AllocationType::kOld));
+
+    for (int round = 0; round < 3; ++round) {
+      for (Handle<FixedArray> holder : holders) {
+        FillWithYoungChains(holder);
+      }
+      // The first scavenge copies the chains within the young generation, the
+      // second one promotes them.
+      YoungGC();
+      for (Handle<FixedArray> holder : holders) VerifyYoungChains(holder);
+      YoungGC();
+      for (Handle<FixedArray> holder : holders) VerifyYoungChains(holder);
+    }
+  }
+};
+
+}  // namespace
+
+TEST_F(ScavengerTest, ParallelScavengeStress) {
+  v8_flags.parallel_scavenge = true;
+  v8_flags.scavenge_work_sharing = true;
+  RunStress();
+}
+
+TEST_F(ScavengerTest, ParallelScavengeStressWithoutWorkSharing) {
+  v8_flags.parallel_scavenge = true;
+  v8_flags.scavenge_work_sharing = false;
+  RunStress();
+}
+
+TEST_F(ScavengerTest, SingleTaskScavengeStress) {
+  v8_flags.parallel_scavenge = false;
+  RunStress();
+}
+
+}  // namespace internal
+}  // namespace v8
@@ -11,6 +11,7 @@
 #include "src/heap/memory-allocator.h"
 #include "src/heap/spaces-inl.h"
 #include "src/utils/ostreams.h"
+#include "test/common/flag-utils.h"
 #include "test/unittests/test-utils.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
@@ -432,6 +433,64 @@ TEST_F(SequentialUnmapperTest, UnmapOnTeardown) {
   tracking_page_allocator()->CheckIsFree(page->address(), page_size);
 #endif  // V8_COMPRESS_POINTERS
 }
+
+TEST_F(SequentialUnmapperTest, PoolIsBoundedAndReleasedWhenIdle) {
+  if (v8_flags.enable_third_party_heap) return;
+  FlagScope<unsigned int> max_pooled_pages(&v8_flags.max_pooled_pages, 1);
+  // Start out with an empty pool.
+  unmapper()->EnsureUnmappingCompleted();
+  Page* first =
+      allocator()->AllocatePage(MemoryAllocator::AllocationMode::kRegular,
+                                static_cast<PagedSpace*>(heap()->old_space()),
+                                Executability::NOT_EXECUTABLE);
+  Page* second =
+      allocator()->AllocatePage(MemoryAllocator::AllocationMode::kRegular,
+                                static_cast<PagedSpace*>(heap()->old_space()),
+                                Executability::NOT_EXECUTABLE);
+  EXPECT_NE(nullptr, first);
+  EXPECT_NE(nullptr, second);
+  allocator()->Free(MemoryAllocator::FreeMode::kConcurrentlyAndPool, first);
+  // The pool is already full, so the second page is unmapped.
+  allocator()->Free(MemoryAllocator::FreeMode::kConcurrentlyAndPool, second);
+  unmapper()->EnsureUnmappingCompletedAndTrimPool();
+  EXPECT_EQ(1u, unmapper()->NumberOfPooledChunks());
+  unmapper()->ReleasePooledChunks();
+  EXPECT_EQ(0u, unmapper()->NumberOfPooledChunks());
+  unmapper()->TearDown();
+}
+
+TEST_F(SequentialUnmapperTest, PooledPageIsReused) {
+  if (v8_flags.enable_third_party_heap) return;
+  FlagScope<unsigned int> max_pooled_pages(&v8_flags.max_pooled_pages, 1);
+  // Start out with an empty pool.
+  unmapper()->EnsureUnmappingCompleted();
+  PagedSpace* space = static_cast<PagedSpace*>(heap()->old_space());
+  Page* page = allocator()->AllocatePage(
+      MemoryAllocator::AllocationMode::kRegular, space, NOT_EXECUTABLE);
+  EXPECT_NE(nullptr, page);
+  const Address address = page->address();
+  const size_t page_size = tracking_page_allocator()->AllocatePageSize();
+  allocator()->Free(MemoryAllocator::FreeMode::kConcurrentlyAndPool, page);
+  unmapper()->EnsureUnmappingCompletedAndTrimPool();
+  EXPECT_EQ(1u, unmapper()->NumberOfPooledChunks());
+  tracking_page_allocator()->CheckPagePermissions(
+      address, page_size, PageAllocator::kNoAccess, false);
+
+  // The uncommitted page is taken from the pool and committed again.
+  Page* reused = allocator()->AllocatePage(
+      MemoryAllocator::AllocationMode::kUsePool, space, NOT_EXECUTABLE);
+  EXPECT_NE(nullptr, reused);
+  EXPECT_EQ(address, reused->address());
+  EXPECT_EQ(0u, unmapper()->NumberOfPooledChunks());
+  tracking_page_allocator()->CheckPagePermissions(address, page_size,
+                                                  PageAllocator::kReadWrite);
+
+  // Reusing the page released its slot, so the page can be pooled again.
+  allocator()->Free(MemoryAllocator::FreeMode::kConcurrentlyAndPool, reused);
+  unmapper()->EnsureUnmappingCompletedAndTrimPool();
+  EXPECT_EQ(1u, unmapper()->NumberOfPooledChunks());
+  unmapper()->TearDown();
+}
 #endif  // !V8_OS_FUCHSIA && !V8_ENABLE_SANDBOX
 
 }  // namespace internal